@@ -89,6 +89,9 @@ void Application::Init() {
     pads.emplace_back(PAD_DISTANCE, PAD_SEGMENTS, 0.f);
     pads.emplace_back(PAD_DISTANCE, PAD_SEGMENTS, 2.f * Geometry::pi / 3.f);
     pads.emplace_back(PAD_DISTANCE, PAD_SEGMENTS, 4.f * Geometry::pi / 3.f);
+    for (auto& pad : pads) {
+        padIndex.Add(pad);
+    }
 
 }
 
@@ -104,6 +107,9 @@ void Application::Step() {
     for (auto& brick : bricks) {
         // Drop down hnging bricks
         brick->Drop();
+        if (brick->ShouldBeDeleted) {
+            brickIndex.Remove(*brick);
+        }
     }
 
     // Remove destroyed bricks
@@ -115,32 +121,30 @@ void Application::Step() {
     }
 
     // Move all balls
-    for (auto& ball : balls) {
-        ball.Step();
-    }
+    Collisions::BallCollider::Step(balls);
 
     // Move all pads
     for (auto& pad : pads) {
         pad.Rotate(movement);
+        padIndex.Update(pad);
     }
 
     // Check for collisions
     for (auto& ball : balls) {
         ball.Collision(bounds);
-        for (auto& pad : pads) {
-            ball.Collision(pad);
-        }
-        for (auto& brick : bricks) {
+        // Only pads and bricks in the sectors around the ball are tested
+        padIndex.ForEachNear(ball, [&](Collisions::BrickCollider& pad) { ball.Collision(pad); });
+        brickIndex.ForEachNear(ball, [&](Collisions::BrickCollider& brick) {
             // Mark brick for removal if collision occurs
-            if (ball.Collision(*brick)) {
-                brick->ShouldBeDeleted = true;
+            if (ball.Collision(brick)) {
+                brick.ShouldBeDeleted = true;
                 score += brickValue;
             }
-        }
-        for (auto& otherBall : balls) {
-            ball.Collision(otherBall);
-        }
+        });
     }
+
+    // Balls collide with each other in the order they touched during the step
+    ballContacts.Resolve(balls);
 }
 
 void Application::Render() {
@@ -209,7 +213,7 @@ void Application::Render() {
     glActiveTexture(GL_TEXTURE0);
 
     // Model matrix
-    const auto modelMatrix = Geometry::Matrix<4>::Identity();
+    const auto modelMatrix = Geometry::Transform3();
     glUniformMatrix4fv(modelMatrixLoc, 1, GL_FALSE, &modelMatrix);
 
     ground.Draw();
@@ -493,10 +497,10 @@ void Application::Gui() {
 }
 
 void Application::DrawObject(const Mesh& mesh, const Collisions::Collider& collider) const {
-    auto modelMatrix = Geometry::Matrix<4>::Identity();
+    auto modelMatrix = Geometry::Transform3();
     class Visitor : public Collisions::ConstColliderVisitor {
     public:
-        explicit Visitor(Geometry::Matrix<4>& modelMatrix)
+        explicit Visitor(Geometry::Transform3& modelMatrix)
             : ModelMatrix(modelMatrix) {}
 
         void operator()(const Collisions::BallCollider& col) override {
@@ -505,11 +509,11 @@ void Application::DrawObject(const Mesh& mesh, const Collisions::Collider& colli
 
         void operator()(const Collisions::BrickCollider& col) override {
             ModelMatrix
-                    .Rotate(-col.AngleStart(), Geometry::Vector<3>{ 0.f, 1.f, 0.f })
+                    .RotateY(-col.AngleStart())
                     .Translate(Geometry::Vector<3>{ 0.f, col.Height(), 0.f });
         }
 
-        Geometry::Matrix<4>& ModelMatrix;
+        Geometry::Transform3& ModelMatrix;
         bool StopThere = false;
     } visitor{ modelMatrix };
     collider.Visit(visitor);
@@ -537,6 +541,7 @@ void Application::SpawnBalls() {
 }
 
 void Application::SpawnBricks() {
+    brickIndex.Clear();
     bricks.clear();
     bricks.reserve(brickRowCount * brickColumnCount);
     auto index = 0;
@@ -545,6 +550,7 @@ void Application::SpawnBricks() {
         const auto height = i * BRICK_HEIGHT;
         for (auto j = 0; j < brickColumnCount; ++j) {
             bricks.emplace_back(std::make_unique<Collisions::BrickCollider>(BRICK_DISTANCE, BRICK_SEGMENTS, 2.f * j * Geometry::pi / brickColumnCount + offset, height));
+            brickIndex.Add(*bricks.back());
             if (index >= brickColumnCount) {
                 const auto first = index - brickColumnCount;
                 const auto second = index - (index % brickColumnCount == brickColumnCount - 1 ? 2 * brickColumnCount - 1 : brickColumnCount - 1);
@@ -98,10 +98,13 @@ private:
     Mesh brick = Mesh::Brick();
 
     // Colliders
-    std::vector<Collisions::BallCollider> balls{};
-    std::vector<Collisions::BrickCollider> pads{};
+    Geometry::aligned_vector<Collisions::BallCollider> balls{};
+    Geometry::aligned_vector<Collisions::BrickCollider> pads{};
     std::vector<std::unique_ptr<Collisions::BrickCollider>> bricks{};
     Collisions::BoundsCollider bounds = { RADIUS };
+    Collisions::ContactQueue ballContacts{};
+    Collisions::PolarIndex padIndex{ SEGMENTS };
+    Collisions::PolarIndex brickIndex{ SEGMENTS };
 
     // Player input
     float movement = 0.f;
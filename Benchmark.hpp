@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace Benchmark {
+
+// Makes a value observable so the optimizer can't drop the work that produced it
+template <typename T>
+inline void KeepAlive(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+#endif
+}
+
+// Times benchmark bodies and prints one CSV line per benchmark:
+//   benchmark,ns_per_op,ops_per_second
+// Names contain no commas, so the output can be diffed between builds or loaded as is.
+// The first command line argument, if any, only runs benchmarks whose name contains it.
+class Runner {
+    constexpr static size_t sampleCount = 7;
+    constexpr static double minimumSampleNs = 1e7;
+
+    std::string filter;
+
+public:
+    Runner(int argc, char** argv)
+        : filter(argc > 1 ? argv[1] : "") {
+        std::printf("benchmark,ns_per_op,ops_per_second\n");
+    }
+
+    // body performs operations operations per call. Calls are batched until a sample takes at least
+    // 10 ms, the reported time is the median of the samples.
+    template <typename Body>
+    void Run(const std::string& name, size_t operations, Body body) {
+        if (name.find(filter) == std::string::npos)
+            return;
+
+        using Clock = std::chrono::steady_clock;
+        const auto time = [&](size_t calls) {
+            const auto start = Clock::now();
+            for (size_t i = 0; i < calls; ++i)
+                body();
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        };
+
+        size_t calls = 1;
+        while (time(calls) < minimumSampleNs)
+            calls *= 2;
+
+        std::array<double, sampleCount> samples;
+        for (auto& sample : samples)
+            sample = time(calls) / static_cast<double>(calls * operations);
+        std::sort(samples.begin(), samples.end());
+        const auto median = samples[sampleCount / 2];
+
+        std::printf("%s,%.3f,%.0f\n", name.c_str(), median, 1e9 / median);
+        std::fflush(stdout);
+    }
+};
+
+} // namespace Benchmark
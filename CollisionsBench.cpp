@@ -0,0 +1,401 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Collisions"
+#include "Geometry"
+
+using namespace Geometry;
+using namespace Collisions;
+using Benchmark::KeepAlive;
+
+namespace {
+// Same arena Application builds, one ring of bricks on the ground and the three pads
+struct Scene {
+    BoundsCollider bounds{ RADIUS };
+    aligned_vector<BrickCollider> pads;
+    aligned_vector<BrickCollider> bricks;
+
+    Scene() {
+        for (unsigned i = 0; i < 3; ++i)
+            pads.emplace_back(PAD_DISTANCE, PAD_SEGMENTS, 2.f * i * pi / 3.f);
+        for (unsigned i = 0; i < 10; ++i)
+            bricks.emplace_back(BRICK_DISTANCE, BRICK_SEGMENTS, 2.f * i * pi / 10.f);
+    }
+};
+
+// Balls spawned between the bricks and the pads like Application::SpawnBalls
+aligned_vector<BallCollider> RandomBalls(size_t count) {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> distance(BRICK_DISTANCE + BRICK_WIDTH + 2.f, PAD_DISTANCE - 2.f);
+    std::uniform_real_distribution<float> angle(-pi, pi);
+    std::uniform_real_distribution<float> speed(0.2f, 1.f);
+    aligned_vector<BallCollider> ret;
+    ret.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto position = Vector<3>{ distance(e), 1.f, 0.f }.Rotate(angle(e), { 0.f, 1.f, 0.f });
+        auto velocity = Vector<3>::Normalized(position) * speed(e);
+        ret.emplace_back(std::move(position), std::move(velocity), 1.f, 1.f);
+    }
+    return ret;
+}
+
+// One Application::Step worth of work, bricks are never removed so every frame costs the same
+template <typename Ball, typename Allocator>
+void Frame(std::vector<Ball, Allocator>& balls, Scene& scene) {
+    Ball::Step(balls);
+    for (auto& pad : scene.pads)
+        pad.Rotate(0.01f);
+    for (auto& ball : balls) {
+        ball.Collision(scene.bounds);
+        for (auto& pad : scene.pads)
+            ball.Collision(pad);
+        for (auto& brick : scene.bricks)
+            ball.Collision(brick);
+        for (auto& other : balls)
+            ball.Collision(other);
+    }
+}
+
+// Balls anywhere in a disk that grows with count, so about a tenth of its area is covered by balls
+aligned_vector<BallCollider> ScatteredBalls(size_t count, float radius) {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::uniform_real_distribution<float> angle(-pi, pi);
+    aligned_vector<BallCollider> ret;
+    ret.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto position = Vector<3>{ radius * std::sqrt(unit(e)), 1.f, 0.f }.Rotate(angle(e), { 0.f, 1.f, 0.f });
+        ret.emplace_back(std::move(position), Vector<3>(), 1.f, 1.f);
+    }
+    return ret;
+}
+
+float ScatteredRadius(size_t count) {
+    return std::sqrt(10.f * static_cast<float>(count));
+}
+
+void BroadPhaseBenchmarks(Benchmark::Runner& runner) {
+    for (const size_t count : { 10, 100, 1000, 10000, 100000 }) {
+        const auto suffix = "/" + std::to_string(count);
+        const auto radius = ScatteredRadius(count);
+        const auto balls = ScatteredBalls(count, radius);
+
+        // Rebuilding and walking the grid every frame, with the narrow phase test on every candidate
+        UniformGrid grid{ radius };
+        runner.Run("broad_phase/grid" + suffix, count, [&] {
+            grid.Build(balls);
+            size_t overlapping = 0;
+            grid.ForEachPair([&](size_t first, size_t second) { overlapping += balls[first].DidCollide(balls[second]); });
+            KeepAlive(overlapping);
+        });
+
+        // All pairs once, half of what Application::Step used to test. Quadratic, so big counts are skipped.
+        if (count > 10000)
+            continue;
+        runner.Run("broad_phase/brute_force" + suffix, count, [&] {
+            size_t overlapping = 0;
+            for (size_t i = 0; i < balls.size(); ++i)
+                for (size_t j = i + 1; j < balls.size(); ++j)
+                    overlapping += balls[i].DidCollide(balls[j]);
+            KeepAlive(overlapping);
+        });
+    }
+}
+
+// Same disk as ScatteredBalls, but the balls crowd around a hundredth as many centers and all drift slowly
+aligned_vector<BallCollider> ClusteredBalls(size_t count, float radius) {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::uniform_real_distribution<float> angle(-pi, pi);
+    std::normal_distribution<float> spread(0.f, 5.f);
+    std::uniform_real_distribution<float> speed(-0.05f, 0.05f);
+    std::vector<Vector<3>> centers;
+    for (size_t i = 0; i < std::max<size_t>(count / 100, 1); ++i)
+        centers.push_back(Vector<3>{ radius * std::sqrt(unit(e)), 1.f, 0.f }.Rotate(angle(e), { 0.f, 1.f, 0.f }));
+    aligned_vector<BallCollider> ret;
+    ret.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        ret.emplace_back(centers[i % centers.size()] + Vector<3>{ spread(e), 0.f, spread(e) }, Vector<3>{ speed(e), 0.f, speed(e) }, 1.f, 1.f);
+    return ret;
+}
+
+// Scattered balls with the slow drift of the clustered ones
+aligned_vector<BallCollider> DriftingBalls(size_t count, float radius) {
+    std::default_random_engine e(43);
+    std::uniform_real_distribution<float> speed(-0.05f, 0.05f);
+    aligned_vector<BallCollider> ret;
+    ret.reserve(count);
+    for (const auto& ball : ScatteredBalls(count, radius))
+        ret.emplace_back(Vector<3>(ball.Position()), Vector<3>{ speed(e), 0.f, speed(e) }, 1.f, 1.f);
+    return ret;
+}
+
+void AABBTreeBenchmarks(Benchmark::Runner& runner) {
+    using Distribution = aligned_vector<BallCollider> (*)(size_t, float);
+    const std::pair<const char*, Distribution> distributions[] = { { "uniform", DriftingBalls }, { "clustered", ClusteredBalls } };
+    for (const auto& [name, distribution] : distributions) {
+        for (const size_t count : { 1000, 10000 }) {
+            const auto suffix = "/" + std::string(name) + "/" + std::to_string(count);
+            const auto radius = ScatteredRadius(count);
+
+            // One frame each, moving the balls, refreshing the broad phase and testing every candidate.
+            // Every variant gets its own balls so all of them see the same motion.
+            auto gridBalls = distribution(count, radius);
+            UniformGrid grid{ radius };
+            runner.Run("aabb_tree/frame/grid" + suffix, count, [&] {
+                BallCollider::Step(gridBalls);
+                grid.Build(gridBalls);
+                size_t overlapping = 0;
+                grid.ForEachPair([&](size_t first, size_t second) { overlapping += gridBalls[first].DidCollide(gridBalls[second]); });
+                KeepAlive(overlapping);
+            });
+
+            auto treeBalls = distribution(count, radius);
+            AABBTree tree{ 0.25f };
+            std::vector<AABBTree::Proxy> proxies;
+            for (auto& ball : treeBalls)
+                proxies.push_back(tree.Insert(ball));
+            runner.Run("aabb_tree/frame/tree" + suffix, count, [&] {
+                BallCollider::Step(treeBalls);
+                for (const auto proxy : proxies)
+                    tree.Update(proxy);
+                size_t overlapping = 0;
+                tree.ForEachPair([&](const Collider& first, const Collider& second) {
+                    overlapping += static_cast<const BallCollider&>(first).DidCollide(static_cast<const BallCollider&>(second));
+                });
+                KeepAlive(overlapping);
+            });
+
+            auto bruteBalls = distribution(count, radius);
+            runner.Run("aabb_tree/frame/brute_force" + suffix, count, [&] {
+                BallCollider::Step(bruteBalls);
+                size_t overlapping = 0;
+                for (size_t i = 0; i < bruteBalls.size(); ++i)
+                    for (size_t j = i + 1; j < bruteBalls.size(); ++j)
+                        overlapping += bruteBalls[i].DidCollide(bruteBalls[j]);
+                KeepAlive(overlapping);
+            });
+        }
+    }
+}
+
+void PolarIndexBenchmarks(Benchmark::Runner& runner) {
+    // Application's four rows of ten bricks, and a crowded arena with every row of the ring filled
+    for (const unsigned columns : { 10, 36 }) {
+        const auto suffix = "/" + std::to_string(4 * columns) + "_bricks";
+
+        aligned_vector<BrickCollider> bricks;
+        for (unsigned row = 0; row < 4; ++row)
+            for (unsigned column = 0; column < columns; ++column)
+                bricks.emplace_back(BRICK_DISTANCE, column % 3 + 1, 2.f * column * pi / columns + row * 0.4f);
+        PolarIndex index{ SEGMENTS };
+        for (auto& brick : bricks)
+            index.Add(brick);
+        // Balls anywhere inside the pads, so some are on the brick ring
+        const auto balls = ScatteredBalls(256, PAD_DISTANCE);
+
+        // Narrow phase overlap test for every ball and every brick it is matched with
+        runner.Run("polar_index/query/all_bricks" + suffix, balls.size(), [&] {
+            size_t overlapping = 0;
+            for (const auto& ball : balls)
+                for (const auto& brick : bricks)
+                    overlapping += Overlaps(Sphere<2>{ ball.Position().To2(), ball.Radius }, brick.Sector());
+            KeepAlive(overlapping);
+        });
+        runner.Run("polar_index/query/indexed" + suffix, balls.size(), [&] {
+            size_t overlapping = 0;
+            for (const auto& ball : balls)
+                index.ForEachNear(ball, [&](const BrickCollider& brick) { overlapping += Overlaps(Sphere<2>{ ball.Position().To2(), ball.Radius }, brick.Sector()); });
+            KeepAlive(overlapping);
+        });
+
+        // Pads move every frame, every brick rotating is the worst case for the index
+        runner.Run("polar_index/update" + suffix, bricks.size(), [&] {
+            for (auto& brick : bricks) {
+                brick.Rotate(0.01f);
+                index.Update(brick);
+            }
+        });
+    }
+}
+
+void AngularSweepBenchmarks(Benchmark::Runner& runner) {
+    // Four rings of 36 colliders that all turn a little every frame, the way pads do
+    aligned_vector<BrickCollider> colliders;
+    for (unsigned ring = 0; ring < 4; ++ring)
+        for (unsigned column = 0; column < 36; ++column)
+            colliders.emplace_back(BRICK_DISTANCE + ring * 5.f, column % 3 + 1, 2.f * column * pi / 36 + ring * 0.4f);
+    const auto balls = ScatteredBalls(256, PAD_DISTANCE);
+    const auto overlaps = [](const BallCollider& ball, const BrickCollider& collider) {
+        return Overlaps(Sphere<2>{ ball.Position().To2(), ball.Radius }, collider.Sector());
+    };
+    const auto suffix = "/" + std::to_string(colliders.size()) + "_colliders";
+
+    // One frame each, turning every collider, refreshing the broad phase and testing every candidate
+    runner.Run("angular_sweep/frame/all_pairs" + suffix, balls.size(), [&] {
+        size_t overlapping = 0;
+        for (auto& collider : colliders)
+            collider.Rotate(0.01f);
+        for (const auto& ball : balls)
+            for (const auto& collider : colliders)
+                overlapping += overlaps(ball, collider);
+        KeepAlive(overlapping);
+    });
+
+    PolarIndex index{ SEGMENTS };
+    for (auto& collider : colliders)
+        index.Add(collider);
+    runner.Run("angular_sweep/frame/polar_index" + suffix, balls.size(), [&] {
+        size_t overlapping = 0;
+        for (auto& collider : colliders) {
+            collider.Rotate(0.01f);
+            index.Update(collider);
+        }
+        for (const auto& ball : balls)
+            index.ForEachNear(ball, [&](const BrickCollider& collider) { overlapping += overlaps(ball, collider); });
+        KeepAlive(overlapping);
+    });
+
+    AngularSweep sweep;
+    for (auto& collider : colliders)
+        sweep.Add(collider);
+    runner.Run("angular_sweep/frame/sweep" + suffix, balls.size(), [&] {
+        size_t overlapping = 0;
+        for (auto& collider : colliders)
+            collider.Rotate(0.01f);
+        sweep.Update(balls);
+        sweep.ForEachPair([&](size_t ball, const BrickCollider& collider) { overlapping += overlaps(balls[ball], collider); });
+        KeepAlive(overlapping);
+    });
+}
+
+void BrickContactBenchmarks(Benchmark::Runner& runner) {
+    // Balls that all end the step touching a brick, arriving from every side at a range of speeds
+    const BrickCollider brick{ BRICK_DISTANCE, static_cast<unsigned>(BRICK_SEGMENTS), BRICK_SEGMENTS * -ANGLE / 2.f };
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> distance(BRICK_DISTANCE - 1.f, BRICK_DISTANCE + BRICK_WIDTH + 1.f);
+    std::uniform_real_distribution<float> angle(-0.4f, 0.4f);
+    std::uniform_real_distribution<float> direction(-pi, pi);
+    std::uniform_real_distribution<float> speed(0.2f, 1.5f);
+    aligned_vector<BallCollider> contacts;
+    while (contacts.size() < 256) {
+        auto position = Vector<3>{ distance(e), 1.f, 0.f }.Rotate(angle(e), { 0.f, 1.f, 0.f });
+        const auto heading = direction(e);
+        const auto length = speed(e);
+        auto velocity = Vector<3>{ length * std::cos(heading), 0.f, length * std::sin(heading) };
+        // Only balls coming from outside the brick
+        if (Overlaps(Sphere<2>{ (position - velocity).To2(), 1.f }, brick.Sector()) || !Overlaps(Sphere<2>{ position.To2(), 1.f }, brick.Sector()))
+            continue;
+        contacts.emplace_back(std::move(position), std::move(velocity), 1.f, 2.f);
+    }
+
+    // Every ball is copied fresh, the response moves it out of the brick
+    runner.Run("brick_contact/response", contacts.size(), [&] {
+        size_t hits = 0;
+        for (const auto& contact : contacts) {
+            auto ball = contact;
+            hits += ball.Collision(brick);
+        }
+        KeepAlive(hits);
+    });
+}
+
+void BallEventBenchmarks(Benchmark::Runner& runner) {
+    for (const size_t count : { 1000, 10000 }) {
+        const auto suffix = "/" + std::to_string(count);
+        // A third of the disk covered by balls heading every way, so most of them meet another during the step
+        const auto radius = std::sqrt(3.f * static_cast<float>(count));
+        std::default_random_engine e(42);
+        std::uniform_real_distribution<float> speed(-1.f, 1.f);
+        // The same balls with every hundredth one eight times as fast, only the balls near a fast one should
+        // pay for it
+        aligned_vector<BallCollider> balls;
+        aligned_vector<BallCollider> mixed;
+        balls.reserve(count);
+        mixed.reserve(count);
+        for (const auto& ball : ScatteredBalls(count, radius)) {
+            const Vector<3> velocity{ speed(e), 0.f, speed(e) };
+            balls.emplace_back(Vector<3>(ball.Position()), Vector<3>(velocity), 1.f, 1.f);
+            const auto scale = mixed.size() % 100 == 0 ? 8.f : 1.f;
+            mixed.emplace_back(Vector<3>(ball.Position()), velocity * scale, 1.f, scale);
+        }
+        BallCollider::Step(balls);
+        BallCollider::Step(mixed);
+
+        // Operations are the contacts one step processes, so the rate is events per second
+        ContactQueue queue;
+        auto counted = balls;
+        const auto events = queue.Resolve(counted);
+        runner.Run("ball_events/queue" + suffix, events, [&] {
+            auto step = balls;
+            KeepAlive(queue.Resolve(step));
+        });
+        auto mixedCounted = mixed;
+        runner.Run("ball_events/queue_mixed" + suffix, queue.Resolve(mixedCounted), [&] {
+            auto step = mixed;
+            KeepAlive(queue.Resolve(step));
+        });
+
+        // The pairwise response Application::Step used before, over the same candidates
+        UniformGrid grid{ radius };
+        runner.Run("ball_events/pairwise" + suffix, events, [&] {
+            auto step = balls;
+            grid.Build(step);
+            grid.ForEachPair([&](size_t first, size_t second) { step[first].Collision(step[second]); });
+            KeepAlive(step);
+        });
+    }
+}
+
+void LayoutBenchmarks(Benchmark::Runner& runner) {
+    for (const size_t count : { 16, 256 }) {
+        const auto suffix = "/" + std::to_string(count);
+
+        Scene scene;
+        auto balls = RandomBalls(count);
+        std::vector<PlanarBallCollider> planarBalls(balls.begin(), balls.end());
+        // Per ball frame cost, the ball-ball pass makes it grow with count
+        runner.Run("layout/frame/world" + suffix, count, [&] {
+            Frame(balls, scene);
+            KeepAlive(balls.front().Position());
+        });
+        runner.Run("layout/frame/planar" + suffix, count, [&] {
+            Frame(planarBalls, scene);
+            KeepAlive(planarBalls.front().Position());
+        });
+
+        runner.Run("layout/step/world" + suffix, count, [&] {
+            BallCollider::Step(balls);
+            KeepAlive(balls.front().Position());
+        });
+        runner.Run("layout/step/planar" + suffix, count, [&] {
+            PlanarBallCollider::Step(planarBalls);
+            KeepAlive(planarBalls.front().Position());
+        });
+
+        // Rendering only needs world positions, see what the conversion costs
+        runner.Run("layout/world_position/planar" + suffix, count, [&] {
+            auto sum = Vector<3>();
+            for (const auto& ball : planarBalls)
+                sum += ball.WorldPosition();
+            KeepAlive(sum);
+        });
+    }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Benchmark::Runner runner(argc, argv);
+    LayoutBenchmarks(runner);
+    BroadPhaseBenchmarks(runner);
+    PolarIndexBenchmarks(runner);
+    AngularSweepBenchmarks(runner);
+    AABBTreeBenchmarks(runner);
+    BrickContactBenchmarks(runner);
+    BallEventBenchmarks(runner);
+    return 0;
+}
@@ -0,0 +1,711 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Geometry"
+
+using namespace Geometry;
+using Benchmark::KeepAlive;
+
+namespace {
+// Scalar reference with the iterator loops Vector used before the SIMD backend
+struct ScalarVector {
+    std::array<float, 3> data;
+
+    ScalarVector& operator+=(const ScalarVector& rhs) {
+        auto rhsIt = rhs.data.begin();
+        for (auto lhsIt = data.begin(); lhsIt != data.end(); ++lhsIt, ++rhsIt)
+            *lhsIt += *rhsIt;
+        return *this;
+    }
+
+    friend ScalarVector operator*(ScalarVector vec, float scalar) {
+        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
+            *lhsIt *= scalar;
+        return vec;
+    }
+
+    static float Dot(const ScalarVector& lhs, const ScalarVector& rhs) {
+        auto ret = 0.f;
+        auto rhsIt = rhs.data.begin();
+        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
+            ret += *lhsIt * *rhsIt;
+        return ret;
+    }
+
+    float Magnitude() const {
+        auto ret = 0.f;
+        for (auto& i : data)
+            ret += i * i;
+        return std::sqrt(ret);
+    }
+
+    ScalarVector& Normalize() {
+        const auto mag = Magnitude();
+        if (mag == 0)
+            return *this;
+        for (auto& i : data)
+            i /= mag;
+        return *this;
+    }
+
+    static ScalarVector Cross(const ScalarVector& lhs, const ScalarVector& rhs) {
+        return { { lhs.data[1] * rhs.data[2] - rhs.data[1] * lhs.data[2], lhs.data[2] * rhs.data[0] - rhs.data[2] * lhs.data[0], lhs.data[0] * rhs.data[1] - rhs.data[0] * lhs.data[1] } };
+    }
+};
+
+const size_t benchmarkSize = 4096;
+// Matrix benchmarks cycle through fewer inputs, they are far more expensive per operation
+const size_t matrixCount = 256;
+
+template <typename T, typename Factory>
+std::vector<T> RandomVectors(Factory factory, size_t count = benchmarkSize) {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> dist(-100.f, 100.f);
+    std::vector<T> ret;
+    ret.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        ret.push_back(factory(dist(e), dist(e), dist(e)));
+    return ret;
+}
+
+Vector<3> MakeVector3(float x, float y, float z) { return { x, y, z }; }
+
+// Well conditioned model matrices, like the ones Application builds every frame
+std::vector<Matrix<4>> RandomModelMatrices() {
+    const auto seeds = RandomVectors<Vector<3>>(MakeVector3, matrixCount);
+    std::vector<Matrix<4>> ret;
+    ret.reserve(matrixCount);
+    for (const auto& seed : seeds)
+        ret.push_back(Matrix<4>::Identity().Rotate(seed.X() * 0.01f, seed).Scale({ 2.f, 1.f, 0.5f }).Translate(seed));
+    return ret;
+}
+
+template <size_t Width>
+std::vector<Matrix<Width>> RandomMatrices() {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> dist(-100.f, 100.f);
+    std::vector<Matrix<Width>> ret(matrixCount);
+    for (auto& mat : ret)
+        for (size_t i = 0; i < Width; ++i)
+            for (size_t j = 0; j < Width; ++j)
+                mat[i][j] = dist(e);
+    return ret;
+}
+
+void VectorBenchmarks(Benchmark::Runner& runner) {
+    const auto simd = RandomVectors<Vector<3>>(MakeVector3);
+    const auto scalar = RandomVectors<ScalarVector>([](float x, float y, float z) { return ScalarVector{ { x, y, z } }; });
+    auto simdOut = simd;
+    auto scalarOut = scalar;
+
+    runner.Run("vector3/add_scale/scalar", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            (scalarOut[i] = scalar[i]) += scalar[i - 1] * 0.5f;
+        KeepAlive(scalarOut);
+    });
+    runner.Run("vector3/add_scale/simd", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            (simdOut[i] = simd[i]) += simd[i - 1] * 0.5f;
+        KeepAlive(simdOut);
+    });
+
+    runner.Run("vector3/dot/scalar", benchmarkSize - 1, [&] {
+        auto sum = 0.f;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            sum += ScalarVector::Dot(scalar[i], scalar[i - 1]);
+        KeepAlive(sum);
+    });
+    runner.Run("vector3/dot/simd", benchmarkSize - 1, [&] {
+        auto sum = 0.f;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            sum += Vector<3>::Dot(simd[i], simd[i - 1]);
+        KeepAlive(sum);
+    });
+
+    runner.Run("vector3/magnitude/scalar", benchmarkSize, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            sum += scalar[i].Magnitude();
+        KeepAlive(sum);
+    });
+    runner.Run("vector3/magnitude/simd", benchmarkSize, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            sum += simd[i].Magnitude();
+        KeepAlive(sum);
+    });
+
+    runner.Run("vector3/normalize/scalar", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (scalarOut[i] = scalar[i]).Normalize();
+        KeepAlive(scalarOut);
+    });
+    runner.Run("vector3/normalize/simd", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (simdOut[i] = simd[i]).Normalize();
+        KeepAlive(simdOut);
+    });
+
+    runner.Run("vector3/normalize/fast", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (simdOut[i] = simd[i]).NormalizeFast();
+        KeepAlive(simdOut);
+    });
+
+    // Pair overlap test of BallCollider::DidCollide
+    runner.Run("vector3/overlap/distance", benchmarkSize - 1, [&] {
+        unsigned count = 0;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            count += Vector<3>::Distance(simd[i], simd[i - 1]) < 50.f;
+        KeepAlive(count);
+    });
+    runner.Run("vector3/overlap/distance_squared", benchmarkSize - 1, [&] {
+        unsigned count = 0;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            count += Vector<3>::DistanceSquared(simd[i], simd[i - 1]) < 50.f * 50.f;
+        KeepAlive(count);
+    });
+
+    runner.Run("vector3/cross/scalar", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            scalarOut[i] = ScalarVector::Cross(scalar[i], scalar[i - 1]);
+        KeepAlive(scalarOut);
+    });
+    runner.Run("vector3/cross/simd", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            simdOut[i] = Vector<3>::Cross(simd[i], simd[i - 1]);
+        KeepAlive(simdOut);
+    });
+
+    const auto rotation = Rotation::AroundY(0.3f);
+    runner.Run("vector3/rotate/angle_axis", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (simdOut[i] = simd[i]).Rotate(0.3f, { 0.f, 1.f, 0.f });
+        KeepAlive(simdOut);
+    });
+    runner.Run("vector3/rotate/rotation", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (simdOut[i] = simd[i]).Rotate(rotation);
+        KeepAlive(simdOut);
+    });
+
+    const auto vectors2 = RandomVectors<Vector<2>>([](float x, float, float z) { return Vector<2>{ x, z }; });
+    auto out2 = vectors2;
+    runner.Run("vector2/add_scale", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            (out2[i] = vectors2[i]) += vectors2[i - 1] * 0.5f;
+        KeepAlive(out2);
+    });
+    runner.Run("vector2/dot", benchmarkSize - 1, [&] {
+        auto sum = 0.f;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            sum += Vector<2>::Dot(vectors2[i], vectors2[i - 1]);
+        KeepAlive(sum);
+    });
+    runner.Run("vector2/normalize", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (out2[i] = vectors2[i]).Normalize();
+        KeepAlive(out2);
+    });
+
+    const auto vectors4 = RandomVectors<Vector<4>>([](float x, float y, float z) { return Vector<4>{ x, y, z, 1.f }; });
+    auto out4 = vectors4;
+    runner.Run("vector4/add_scale", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            (out4[i] = vectors4[i]) += vectors4[i - 1] * 0.5f;
+        KeepAlive(out4);
+    });
+    runner.Run("vector4/dot", benchmarkSize - 1, [&] {
+        auto sum = 0.f;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            sum += Vector<4>::Dot(vectors4[i], vectors4[i - 1]);
+        KeepAlive(sum);
+    });
+    runner.Run("vector4/normalize", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            (out4[i] = vectors4[i]).Normalize();
+        KeepAlive(out4);
+    });
+}
+
+void MatrixBenchmarks(Benchmark::Runner& runner) {
+    const auto models = RandomModelMatrices();
+    auto out = models;
+
+    runner.Run("matrix4/multiply", matrixCount - 1, [&] {
+        for (size_t i = 1; i < matrixCount; ++i)
+            out[i] = models[i] * models[i - 1];
+        KeepAlive(out);
+    });
+    // operator* before the SIMD path, through the Row proxies
+    runner.Run("matrix4/multiply/reference", matrixCount - 1, [&] {
+        for (size_t n = 1; n < matrixCount; ++n) {
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 4; ++i) {
+                    auto sum = 0.f;
+                    for (size_t k = 0; k < 4; ++k)
+                        sum += models[n][k][j] * models[n - 1][i][k];
+                    out[n][i][j] = sum;
+                }
+        }
+        KeepAlive(out);
+    });
+    runner.Run("matrix4/transposed_multiply", matrixCount - 1, [&] {
+        for (size_t i = 1; i < matrixCount; ++i)
+            out[i] = Matrix<4>::TransposedMultiply(models[i], models[i - 1]);
+        KeepAlive(out);
+    });
+    runner.Run("matrix4/transpose", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = Matrix<4>::Transposed(models[i]);
+        KeepAlive(out);
+    });
+    runner.Run("matrix4/determinant", matrixCount, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < matrixCount; ++i)
+            sum += models[i].Determinant();
+        KeepAlive(sum);
+    });
+    runner.Run("matrix4/invert/cofactor", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = Matrix<4>::Minors(models[i]).Cofactor().Transpose() / models[i].Minor(0, 0).Determinant();
+        KeepAlive(out);
+    });
+    runner.Run("matrix4/invert/closed_form", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = Matrix<4>::Inverted(models[i]);
+        KeepAlive(out);
+    });
+    runner.Run("matrix4/invert/affine", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = Matrix<4>::InvertedAffine(models[i]);
+        KeepAlive(out);
+    });
+
+    const auto matrices3 = RandomMatrices<3>();
+    auto out3 = matrices3;
+    runner.Run("matrix3/multiply", matrixCount - 1, [&] {
+        for (size_t i = 1; i < matrixCount; ++i)
+            out3[i] = matrices3[i] * matrices3[i - 1];
+        KeepAlive(out3);
+    });
+    runner.Run("matrix3/invert", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out3[i] = Matrix<3>::Inverted(matrices3[i]);
+        KeepAlive(out3);
+    });
+
+    const auto matrices8 = RandomMatrices<8>();
+    auto out8 = matrices8;
+    runner.Run("matrix8/invert/lu", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out8[i] = Matrix<8>::Inverted(matrices8[i]);
+        KeepAlive(out8);
+    });
+
+    // Row vectors times model matrices, the way collision code transforms points
+    const auto points = RandomVectors<Vector<4>>([](float x, float y, float z) { return Vector<4>{ x, y, z, 1.f }; });
+    auto transformed = points;
+    runner.Run("matrix4/vector_times_matrix", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            transformed[i] = points[i] * models[i % matrixCount];
+        KeepAlive(transformed);
+    });
+
+    // Batch transforms against the same work one operator* at a time, on a mesh sized input
+    const size_t pointCount = 1 << 16;
+    const auto meshPoints = RandomVectors<Vector<3>>(MakeVector3, pointCount);
+    auto meshOut = meshPoints;
+    const auto& model = models.front();
+    const auto transposed = Matrix<4>::Transposed(model);
+    runner.Run("matrix4/transform_points/loop", pointCount, [&] {
+        for (size_t i = 0; i < pointCount; ++i)
+            meshOut[i] = (Vector<4>{ meshPoints[i].X(), meshPoints[i].Y(), meshPoints[i].Z(), 1.f } * transposed).To3();
+        KeepAlive(meshOut);
+    });
+    runner.Run("matrix4/transform_points/batch", pointCount, [&] {
+        model.TransformPoints(meshPoints.data(), pointCount, meshOut.data());
+        KeepAlive(meshOut);
+    });
+    runner.Run("matrix4/transform_points/batch_threads", pointCount, [&] {
+        model.TransformPoints(meshPoints.data(), pointCount, meshOut.data(), 0);
+        KeepAlive(meshOut);
+    });
+    runner.Run("matrix4/transform_normals/batch", pointCount, [&] {
+        model.TransformNormals(meshPoints.data(), pointCount, meshOut.data());
+        KeepAlive(meshOut);
+    });
+}
+
+void CameraBenchmarks(Benchmark::Runner& runner) {
+    const auto eyes = RandomVectors<Vector<3>>(MakeVector3, matrixCount);
+    std::vector<Matrix<4>> out(matrixCount);
+
+    runner.Run("camera/look_at", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = LookAt(eyes[i], { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+        KeepAlive(out);
+    });
+    runner.Run("camera/perspective", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = Perspective(45.f + static_cast<float>(i) * 0.01f, 16.f / 9.f, 0.1f, 100.f);
+        KeepAlive(out);
+    });
+    runner.Run("camera/ortho", matrixCount, [&] {
+        for (size_t i = 0; i < matrixCount; ++i)
+            out[i] = Ortho(-1.f, 1.f + static_cast<float>(i) * 0.01f, -1.f, 1.f, 0.1f, 100.f);
+        KeepAlive(out);
+    });
+}
+
+void TransformBenchmarks(Benchmark::Runner& runner) {
+    runner.Run("transform/matrix4_rotate_translate", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const auto model = Matrix<4>::Identity().Rotate(i * 0.001f, { 0.f, 1.f, 0.f }).Translate({ 0.f, 1.f, 0.f });
+            KeepAlive(model);
+        }
+    });
+    runner.Run("transform/transform3_rotate_translate", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const auto model = Transform3().RotateY(i * 0.001f).Translate({ 0.f, 1.f, 0.f });
+            KeepAlive(model);
+        }
+    });
+}
+
+void VectorArrayBenchmarks(Benchmark::Runner& runner) {
+    auto positions = RandomVectors<Vector<3>>(MakeVector3);
+    auto velocities = RandomVectors<Vector<3>>([](float x, float y, float z) { return Vector<3>{ z, y, x } * 0.01f; });
+    VectorArray<3> positionArray, velocityArray;
+    for (size_t i = 0; i < benchmarkSize; ++i) {
+        positionArray.PushBack(positions[i]);
+        velocityArray.PushBack(velocities[i]);
+    }
+    const std::vector<float> limits(benchmarkSize, 1.f);
+    std::vector<float> out(benchmarkSize);
+
+    runner.Run("vector_array/step/aos", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            positions[i] += velocities[i];
+            if (velocities[i].Magnitude() > limits[i])
+                velocities[i] *= 0.9f;
+        }
+        KeepAlive(positions);
+    });
+    runner.Run("vector_array/step/soa", benchmarkSize, [&] {
+        positionArray.Axpy(1.f, velocityArray);
+        velocityArray.ScaleAbove(limits.data(), 0.9f);
+        KeepAlive(positionArray);
+    });
+
+    runner.Run("vector_array/distances/aos", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            out[i] = Vector<3>::Distance(positions[i], positions.front());
+        KeepAlive(out);
+    });
+    runner.Run("vector_array/distances/soa", benchmarkSize, [&] {
+        VectorArray<3>::Distances(positionArray, positions.front(), out.data());
+        KeepAlive(out);
+    });
+}
+
+// One step of the ball loop in Application::Step, generic over the scalar type
+template <typename T>
+size_t CollisionStep(std::vector<Vector<3, T>>& positions, const std::vector<Vector<3, T>>& velocities, T radius, T bounds) {
+    size_t contacts = 0;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] += velocities[i];
+        if (positions[i].Magnitude() > bounds - radius)
+            ++contacts;
+    }
+    for (size_t i = 0; i < positions.size(); ++i)
+        for (size_t j = i + 1; j < positions.size(); ++j)
+            if (Vector<3, T>::Distance(positions[i], positions[j]) < radius + radius)
+                ++contacts;
+    return contacts;
+}
+
+// Reports time per ball pair. Balls start inside the game arena, 40 units around the origin, and every run
+// steps them from there, so squared distances stay well within Fixed's range.
+template <typename T>
+void CollisionBenchmark(Benchmark::Runner& runner, const std::string& name) {
+    const size_t ballCount = 256;
+    const auto source = RandomVectors<Vector<3>>([](float x, float, float z) { return Vector<3>{ 0.4f * x, 0.f, 0.4f * z }; }, ballCount);
+    std::vector<Vector<3, T>> start, velocities;
+    for (const auto& ball : source) {
+        start.push_back({ T(ball.X()), T(0), T(ball.Z()) });
+        velocities.push_back({ T(ball.Z() * 0.01f), T(0), T(ball.X() * 0.01f) });
+    }
+
+    auto positions = start;
+    runner.Run(name, ballCount * (ballCount - 1) / 2, [&] {
+        positions = start;
+        KeepAlive(CollisionStep(positions, velocities, T(1), T(40)));
+    });
+}
+
+void ExpressionBenchmarks(Benchmark::Runner& runner) {
+    const auto positions = RandomVectors<Vector<3>>(MakeVector3);
+    const auto velocities = RandomVectors<Vector<2>>([](float x, float, float z) { return Vector<2>{ x, z }; });
+    const auto normals = RandomVectors<Vector<2>>([](float x, float, float z) { return Vector<2>::Normalized({ x, z }); });
+    std::vector<Vector<2>> reflected(benchmarkSize);
+    std::vector<Vector<3>> moved(benchmarkSize);
+
+    // Response formulas from the ball colliders
+    runner.Run("expression/reflect/eager", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            reflected[i] = 2.f * Vector<2>::Dot(velocities[i], normals[i]) * normals[i] - velocities[i];
+        KeepAlive(reflected);
+    });
+    runner.Run("expression/reflect/lazy", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            reflected[i] = 2.f * Vector<2>::Dot(velocities[i], normals[i]) * Lazy(normals[i]) - Lazy(velocities[i]);
+        KeepAlive(reflected);
+    });
+
+    runner.Run("expression/corner_push/eager", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            moved[i] = positions[i] + (positions[i] - positions[i - 1]) * 0.5f / 3.f;
+        KeepAlive(moved);
+    });
+    runner.Run("expression/corner_push/lazy", benchmarkSize - 1, [&] {
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            moved[i] = Lazy(positions[i]) + (Lazy(positions[i]) - Lazy(positions[i - 1])) * 0.5f / 3.f;
+        KeepAlive(moved);
+    });
+}
+
+void TrigonometryBenchmarks(Benchmark::Runner& runner) {
+    const auto vectors = RandomVectors<Vector<3>>(MakeVector3);
+
+    runner.Run("trigonometry/sincos/std", benchmarkSize, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            sum += std::sin(vectors[i].X()) * std::cos(vectors[i].X());
+        KeepAlive(sum);
+    });
+    runner.Run("trigonometry/sincos/polynomial", benchmarkSize, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const auto sineCosine = SinCos(vectors[i].X());
+            sum += sineCosine.sine * sineCosine.cosine;
+        }
+        KeepAlive(sum);
+    });
+
+    std::vector<float> xs(benchmarkSize);
+    std::vector<float> zs(benchmarkSize);
+    for (size_t i = 0; i < benchmarkSize; ++i) {
+        xs[i] = vectors[i].X();
+        zs[i] = vectors[i].Z();
+    }
+    std::vector<float> sines(benchmarkSize);
+    std::vector<float> cosines(benchmarkSize);
+    runner.Run("trigonometry/sincos/span", benchmarkSize, [&] {
+        SinCos(xs.data(), benchmarkSize, sines.data(), cosines.data());
+        KeepAlive(sines);
+        KeepAlive(cosines);
+    });
+
+    runner.Run("trigonometry/atan2/std", benchmarkSize, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            sum += std::atan2(vectors[i].Z(), vectors[i].X());
+        KeepAlive(sum);
+    });
+    runner.Run("trigonometry/atan2/polynomial", benchmarkSize, [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            sum += Atan2(vectors[i].Z(), vectors[i].X());
+        KeepAlive(sum);
+    });
+
+    runner.Run("trigonometry/atan2/span", benchmarkSize, [&] {
+        Atan2(zs.data(), xs.data(), benchmarkSize, sines.data());
+        KeepAlive(sines);
+    });
+
+    std::vector<float> squares(benchmarkSize);
+    for (size_t i = 0; i < benchmarkSize; ++i)
+        squares[i] = vectors[i].MagnitudeSquared();
+    runner.Run("trigonometry/sqrt/std", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i)
+            sines[i] = std::sqrt(squares[i]);
+        KeepAlive(sines);
+    });
+    runner.Run("trigonometry/sqrt/span", benchmarkSize, [&] {
+        Sqrt(squares.data(), benchmarkSize, sines.data());
+        KeepAlive(sines);
+    });
+
+    // Polar coordinates of every ball, one Vector at a time and as one pass over the lanes
+    VectorArray<3> positions;
+    for (const auto& vector : vectors)
+        positions.PushBack(vector);
+    runner.Run("trigonometry/polar/per_vector", benchmarkSize, [&] {
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            sines[i] = vectors[i].To2().Magnitude();
+            cosines[i] = Atan2(vectors[i].Z(), vectors[i].X());
+        }
+        KeepAlive(sines);
+        KeepAlive(cosines);
+    });
+    runner.Run("trigonometry/polar/vector_array", benchmarkSize, [&] {
+        positions.Polar(sines.data(), cosines.data());
+        KeepAlive(sines);
+        KeepAlive(cosines);
+    });
+
+    // Segment boundaries of a brick mesh, from the old incremental loop and from the table
+    const AngleTable table(-2 * pi / 36, 37);
+    const auto s = Sin(table.Step());
+    const auto c = Cos(table.Step());
+    std::vector<Vector<2>> boundaries(table.Count() * 2);
+    runner.Run("trigonometry/segment_rotation/incremental", boundaries.size(), [&] {
+        Vector<2> inner{ 10.f, 0.f };
+        Vector<2> outer{ 13.f, 0.f };
+        for (size_t k = 0; k < table.Count(); ++k) {
+            boundaries[2 * k] = inner;
+            boundaries[2 * k + 1] = outer;
+            inner = { inner[0] * c - inner[1] * s, inner[0] * s + inner[1] * c };
+            outer = { outer[0] * c - outer[1] * s, outer[0] * s + outer[1] * c };
+        }
+        KeepAlive(boundaries);
+    });
+    runner.Run("trigonometry/segment_rotation/angle_table", boundaries.size(), [&] {
+        const Vector<2> start[] = { { 10.f, 0.f }, { 13.f, 0.f } };
+        for (size_t k = 0; k < table.Count(); ++k)
+            table.Rotate(start, 2, k, boundaries.data() + 2 * k);
+        KeepAlive(boundaries);
+    });
+}
+
+// Polar cone test of BallCollider against a ring of bricks, with the old per-brick 2 pi shifts and
+// with AngleInterval
+void AngleBenchmarks(Benchmark::Runner& runner) {
+    const auto vectors = RandomVectors<Vector<3>>(MakeVector3);
+    const auto width = 2 * pi / 12;
+    std::vector<float> starts;
+    std::vector<AngleInterval> intervals;
+    for (unsigned i = 0; i < 12; ++i) {
+        starts.push_back(Angle(i * width).Radians());
+        intervals.emplace_back(Angle(starts.back() - width), width);
+    }
+
+    runner.Run("angle/cone_test/shifted", benchmarkSize * starts.size(), [&] {
+        unsigned count = 0;
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const auto positionAngle = Atan2(vectors[i].Z(), vectors[i].X());
+            for (const auto start : starts) {
+                auto otherStart = start;
+                auto otherEnd = start - width;
+                if (otherEnd < -pi / 2 && positionAngle > 0.f) {
+                    otherStart += 2 * pi;
+                    otherEnd += 2 * pi;
+                } else if (otherStart > pi / 2 && positionAngle < 0.f) {
+                    otherStart -= 2 * pi;
+                    otherEnd -= 2 * pi;
+                }
+                count += positionAngle < otherStart && positionAngle > otherEnd;
+            }
+        }
+        KeepAlive(count);
+    });
+    runner.Run("angle/cone_test/interval", benchmarkSize * intervals.size(), [&] {
+        unsigned count = 0;
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const auto positionAngle = Angle::Polar(vectors[i].To2());
+            for (const auto& interval : intervals)
+                count += interval.Contains(positionAngle);
+        }
+        KeepAlive(count);
+    });
+}
+
+void PrimitiveBenchmarks(Benchmark::Runner& runner) {
+    const auto vectors = RandomVectors<Vector<3>>(MakeVector3);
+    std::vector<Sphere<3>> spheres;
+    std::vector<AABB<3>> boxes;
+    std::vector<Ray<3>> rays;
+    for (size_t i = 0; i < benchmarkSize; ++i) {
+        spheres.push_back({ vectors[i], 10.f });
+        boxes.push_back(AABB<3>::Around(spheres.back()));
+        rays.push_back({ vectors[i], vectors[(i + 1) % benchmarkSize] - vectors[i] });
+    }
+
+    runner.Run("primitives/overlap/sphere_sphere", benchmarkSize - 1, [&] {
+        unsigned count = 0;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            count += Overlaps(spheres[i], spheres[i - 1]);
+        KeepAlive(count);
+    });
+    runner.Run("primitives/overlap/aabb_aabb", benchmarkSize - 1, [&] {
+        unsigned count = 0;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            count += Overlaps(boxes[i], boxes[i - 1]);
+        KeepAlive(count);
+    });
+    runner.Run("primitives/overlap/sphere_aabb", benchmarkSize - 1, [&] {
+        unsigned count = 0;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            count += Overlaps(spheres[i], boxes[i - 1]);
+        KeepAlive(count);
+    });
+
+    runner.Run("primitives/ray_cast/sphere", benchmarkSize - 1, [&] {
+        auto sum = 0.f;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            sum += RayCast(rays[i], spheres[i - 1]).value_or(0.f);
+        KeepAlive(sum);
+    });
+    runner.Run("primitives/ray_cast/aabb", benchmarkSize - 1, [&] {
+        auto sum = 0.f;
+        for (size_t i = 1; i < benchmarkSize; ++i)
+            sum += RayCast(rays[i], boxes[i - 1]).value_or(0.f);
+        KeepAlive(sum);
+    });
+
+    // A ring of brick sized sectors against points spread over the arena
+    std::vector<AnnularSector> sectors;
+    for (unsigned i = 0; i < 12; ++i)
+        sectors.emplace_back(30.f, 33.f, AngleInterval(Angle(i * 2 * pi / 12), pi / 6));
+    runner.Run("primitives/overlap/circle_sector", benchmarkSize * sectors.size(), [&] {
+        unsigned count = 0;
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const Sphere<2> circle{ vectors[i].To2() * 0.4f, 1.f };
+            for (const auto& sector : sectors)
+                count += Overlaps(circle, sector);
+        }
+        KeepAlive(count);
+    });
+    runner.Run("primitives/ray_cast/sector", benchmarkSize * sectors.size(), [&] {
+        auto sum = 0.f;
+        for (size_t i = 0; i < benchmarkSize; ++i) {
+            const Ray<2> ray{ rays[i].origin.To2() * 0.4f, rays[i].direction.To2() };
+            for (const auto& sector : sectors)
+                sum += RayCast(ray, sector).value_or(0.f);
+        }
+        KeepAlive(sum);
+    });
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Benchmark::Runner runner(argc, argv);
+    VectorBenchmarks(runner);
+    MatrixBenchmarks(runner);
+    CameraBenchmarks(runner);
+    TransformBenchmarks(runner);
+    VectorArrayBenchmarks(runner);
+    CollisionBenchmark<float>(runner, "scalar_types/collision_step/float");
+    CollisionBenchmark<double>(runner, "scalar_types/collision_step/double");
+    CollisionBenchmark<Fixed>(runner, "scalar_types/collision_step/fixed");
+    ExpressionBenchmarks(runner);
+    TrigonometryBenchmarks(runner);
+    AngleBenchmarks(runner);
+    PrimitiveBenchmarks(runner);
+    return 0;
+}
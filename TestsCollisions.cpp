@@ -1,5 +1,9 @@
 #include "catch.hpp"
 
+#include <memory>
+#include <random>
+#include <set>
+
 #include "Collisions"
 #include "Geometry"
 
@@ -53,4 +57,646 @@ TEST_CASE("Ball-Brick collision detection") {
     // CHECK(BallCollider{ Vector<3>{ 2.9f, 0.f, -1.1f }, Vector<3>(), 1.f }.DidCollide(brick1));
     // CHECK_FALSE(BallCollider{ Vector<3>{ -1.1f, 0.f, -2.9f }, Vector<3>(), 1.f }.DidCollide(brick1));
     // CHECK_FALSE(BallCollider{ Vector<3>{ -1.1f, 0.f, 2.9f }, Vector<3>(), 1.f }.DidCollide(brick1));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Ball-Brick collision across the wraparound") {
+    // Start wall just past -pi, the end wall wraps around to just below pi
+    const BrickCollider brick{ 10.f, 3, -pi + 0.1f };
+    REQUIRE(brick.Interval().Contains(Angle(pi)));
+    REQUIRE_FALSE(brick.Interval().Contains(Angle(0.f)));
+
+    BallCollider inside{ Vector<3>{ -11.5f, 0.f, 0.f }, Vector<3>{ 0.1f, 0.f, 0.f }, 1.f };
+    CHECK(inside.Collision(brick));
+
+    BallCollider opposite{ Vector<3>{ 11.5f, 0.f, 0.f }, Vector<3>{ 0.1f, 0.f, 0.f }, 1.f };
+    CHECK_FALSE(opposite.Collision(brick));
+
+    // Just past the start wall, hits its side
+    BallCollider side{ Vector<3>(Vector<3>{ -11.5f, 0.f, 0.f }.Rotate(0.15f, { 0.f, -1.f, 0.f })), Vector<3>(), 1.f };
+    CHECK(side.Collision(brick));
+}
+
+TEST_CASE("Ball-Brick swept collision") {
+    // Centered on angle 0, from 10 to 13
+    const BrickCollider brick{ 10.f, 3, pi / 12.f };
+
+    // Moved from 8 to 15 in one step, right through the brick, and bounced off the inner wall at 9.5
+    BallCollider fast{ Vector<3>{ 8.f, 1.f, 0.f }, Vector<3>{ 7.f, 0.f, 0.f }, 0.5f, 10.f };
+    fast.Step();
+    REQUIRE(fast.Collision(brick));
+    CHECK(fast.Position().X() == Approx(4.f));
+    CHECK(fast.Position().Y() == 1.f);
+    CHECK(fast.Position().Z() == Approx(0.f).margin(1e-5f));
+    CHECK(fast.Velocity().X() == Approx(-7.f));
+
+    // Slides into the side wall at the start angle
+    const auto wall = Vector<2>{ std::cos(pi / 12.f), std::sin(pi / 12.f) };
+    const auto outward = Vector<2>{ -wall[1], wall[0] };
+    const auto from = wall * 11.5f + outward * 3.f;
+    PlanarBallCollider side{ Vector<2>(from), outward * -3.f, 1.f, 10.f };
+    side.Step();
+    REQUIRE(side.Collision(brick));
+    CHECK(Vector<2>::Dot(side.Velocity(), outward) == Approx(3.f));
+    CHECK(Vector<2>::Dot(side.Position(), outward) == Approx(2.f));
+
+    // Any fast ball crossing the brick bounces off it and keeps its speed, any other one is untouched
+    std::default_random_engine e(19);
+    std::uniform_real_distribution<float> coordinate(-20.f, 20.f);
+    std::uniform_real_distribution<float> speed(-6.f, 6.f);
+    unsigned hits = 0;
+    for (unsigned i = 0; i < 2000; ++i) {
+        const Vector<2> start{ coordinate(e), coordinate(e) };
+        const Vector<2> motion{ speed(e), speed(e) };
+        if (Overlaps(Sphere<2>{ start, 1.f }, brick.Sector()))
+            continue;
+        auto crosses = false;
+        for (auto t = 0.f; t <= 1.f && !crosses; t += 0.001f)
+            crosses = Overlaps(Sphere<2>{ start + motion * t, 1.f }, brick.Sector());
+
+        PlanarBallCollider ball{ Vector<2>(start), Vector<2>(motion), 1.f, 10.f };
+        ball.Step();
+        REQUIRE(ball.Collision(brick) == crosses);
+        if (!crosses) {
+            REQUIRE(ball.Position() == start + motion);
+            continue;
+        }
+        ++hits;
+        REQUIRE(ball.Velocity().Magnitude() == Approx(motion.Magnitude()));
+        REQUIRE(Vector<2>::Distance(ball.Position(), start) <= motion.Magnitude() + 1e-3f);
+    }
+    CHECK(hits > 20);
+
+    SECTION("Path recorded by the step") {
+        // Damped to 18 after moving by 20, so the path can't be recovered from the velocity
+        BallCollider damped{ Vector<3>{ 8.f, 1.f, 0.f }, Vector<3>{ 20.f, 0.f, 0.f }, 0.5f, 1.f };
+        damped.Step();
+        CHECK(damped.Start() == Vector<3>{ 8.f, 1.f, 0.f });
+        REQUIRE(damped.Collision(brick));
+        CHECK(damped.Position().X() == Approx(-9.f));
+        CHECK(damped.Velocity().X() == Approx(-18.f));
+        CHECK(damped.Start().X() == Approx(9.5f));
+
+        // Sent back by the bounds with a reflected velocity pointing back along a path through a brick it
+        // never reached
+        BallCollider reflected{ Vector<3>{ 0.f, 1.f, 19.f }, Vector<3>{ 8.f, 0.f, 0.f }, 0.5f, 10.f };
+        reflected.Step();
+        reflected.Collision(BoundsCollider{ 20.f });
+        REQUIRE(reflected.Start() == reflected.Position());
+        const auto end = reflected.Position().To2();
+        const auto motion = reflected.Velocity().To2();
+        const BrickCollider behind{ 20.f, 3, Angle::Polar(end - motion * 0.5f).Radians() + pi / 12.f };
+        REQUIRE(Sweep(Sphere<2>{ end - motion, 0.5f }, motion, behind.Sector()));
+        CHECK_FALSE(reflected.Collision(behind));
+        CHECK(reflected.Position() == Vector<3>{ 0.f, 1.f, 19.f });
+    }
+}
+
+TEST_CASE("Batched ball step") {
+    std::vector<BallCollider> batched;
+    for (unsigned i = 0; i < 20; ++i)
+        batched.emplace_back(Vector<3>{ float(i), 1.f, -float(i) }, Vector<3>{ 0.1f * i, 0.f, 0.05f * i }, 1.f, 1.f);
+    auto single = batched;
+
+    for (unsigned step = 0; step < 10; ++step) {
+        BallCollider::Step(batched);
+        for (auto& ball : single)
+            ball.Step();
+    }
+
+    for (size_t i = 0; i < batched.size(); ++i) {
+        CHECK(batched[i].Position() == single[i].Position());
+        CHECK(batched[i].Velocity() == single[i].Velocity());
+        // Filled by the pass over all balls and computed on demand, same either way
+        CHECK(batched[i].PositionAngle() == single[i].PositionAngle());
+    }
+}
+
+TEST_CASE("Brick corners and velocity") {
+    const auto requireApprox = [](const Vector<3>& lhs, const Vector<3>& rhs) {
+        REQUIRE(lhs.X() == Approx(rhs.X()).margin(0.0001f));
+        REQUIRE(lhs.Y() == Approx(rhs.Y()).margin(0.0001f));
+        REQUIRE(lhs.Z() == Approx(rhs.Z()).margin(0.0001f));
+    };
+    const Vector<3> up{ 0.f, 1.f, 0.f };
+
+    BrickCollider brick{ 10.f, 3, 0.5f };
+    for (unsigned i = 0; i < 50; ++i) {
+        brick.Rotate(0.3f);
+
+        requireApprox(brick.InnerStartCorner(), Vector<3>{ brick.InnerRadius(), 1.f, 0.f }.Rotate(-brick.AngleStart(), up));
+        requireApprox(brick.InnerEndCorner(), Vector<3>{ brick.InnerRadius(), 1.f, 0.f }.Rotate(-brick.AngleEnd(), up));
+        requireApprox(brick.OuterStartCorner(), Vector<3>{ brick.OuterRadius(), 1.f, 0.f }.Rotate(-brick.AngleStart(), up));
+        requireApprox(brick.OuterEndCorner(), Vector<3>{ brick.OuterRadius(), 1.f, 0.f }.Rotate(-brick.AngleEnd(), up));
+
+        const Vector<3> position{ 12.f, 0.f, 3.f };
+        requireApprox(brick.Velocity(position), (Vector<3>(position).Rotate(0.3f, up) - position).Invert());
+    }
+
+    brick.Rotate(0.f);
+    CHECK(brick.Velocity({ 12.f, 0.f, 3.f }) == Vector<3>());
+}
+
+TEST_CASE("Planar ball collider") {
+    SECTION("Conversion helpers") {
+        const BallCollider ball{ Vector<3>{ 3.f, 2.f, -4.f }, Vector<3>{ 0.5f, 0.f, 0.25f }, 1.f, 2.f };
+        const PlanarBallCollider planar{ ball };
+
+        CHECK(planar.Position() == Vector<2>{ 3.f, -4.f });
+        CHECK(planar.Velocity() == Vector<2>{ 0.5f, 0.25f });
+        CHECK(planar.WorldPosition() == ball.Position());
+        CHECK(planar.WorldVelocity() == ball.Velocity());
+        CHECK(planar.Height == 2.f);
+        CHECK(planar.Radius == ball.Radius);
+        CHECK(planar.Mass == ball.Mass);
+        CHECK(planar.MaxVelocity == ball.MaxVelocity);
+    }
+
+    SECTION("Same simulation as the world space collider") {
+        // At the height game balls are at, where the world space bounds check sees the vertical offset
+        const BoundsCollider bounds{ 20.f };
+        std::vector<BallCollider> balls;
+        std::vector<PlanarBallCollider> planarBalls;
+        for (unsigned i = 0; i < 12; ++i) {
+            const auto angle = 0.5f * i;
+            const Vector<3> position{ (2.f + i) * std::cos(angle), 1.f, (2.f + i) * std::sin(angle) };
+            const Vector<3> velocity{ 0.8f * std::sin(3.f * angle), 0.f, 0.8f * std::cos(2.f * angle) };
+            balls.emplace_back(Vector<3>(position), Vector<3>(velocity), 1.f, 1.f);
+            planarBalls.emplace_back(balls.back());
+        }
+
+        for (unsigned step = 0; step < 500; ++step) {
+            BallCollider::Step(balls);
+            PlanarBallCollider::Step(planarBalls);
+            for (size_t i = 0; i < balls.size(); ++i) {
+                balls[i].Collision(bounds);
+                planarBalls[i].Collision(bounds);
+                for (size_t j = 0; j < balls.size(); ++j) {
+                    balls[i].Collision(balls[j]);
+                    planarBalls[i].Collision(planarBalls[j]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < balls.size(); ++i) {
+            CHECK(planarBalls[i].WorldPosition() == balls[i].Position());
+            CHECK(planarBalls[i].WorldVelocity() == balls[i].Velocity());
+        }
+
+        // Inside the bounds on the plane, outside once the height is added
+        const BallCollider edge{ Vector<3>{ 18.99f, 1.f, 0.f }, Vector<3>(), 1.f };
+        CHECK(edge.DidCollide(bounds));
+        CHECK(PlanarBallCollider(edge).DidCollide(bounds));
+    }
+
+    SECTION("Brick collisions") {
+        const BrickCollider brick{ 10.f, 3, -pi + 0.1f };
+
+        PlanarBallCollider inside{ Vector<2>{ -11.5f, 0.f }, Vector<2>{ 0.1f, 0.f }, 1.f };
+        CHECK(inside.Collision(brick));
+        CHECK(inside.Velocity()[0] < 0.f);
+
+        PlanarBallCollider opposite{ Vector<2>{ 11.5f, 0.f }, Vector<2>{ 0.1f, 0.f }, 1.f };
+        CHECK_FALSE(opposite.Collision(brick));
+        CHECK_FALSE(PlanarBallCollider(Vector<2>{ -11.5f, 0.f }, Vector<2>(), 1.f).Collision(BrickCollider{ 10.f, 3, -pi + 0.1f, BRICK_HEIGHT }));
+    }
+}
+
+TEST_CASE("Uniform grid broad phase") {
+    std::default_random_engine e(7);
+    std::uniform_real_distribution<float> coordinate(-22.f, 22.f);
+    std::uniform_real_distribution<float> size(0.2f, 1.5f);
+    UniformGrid grid{ 20.f };
+
+    // Every overlapping pair has to be among the candidates, and every candidate is reported once
+    const auto checkPairs = [&](const std::vector<BallCollider>& balls) {
+        grid.Build(balls);
+        std::set<std::pair<size_t, size_t>> pairs;
+        grid.ForEachPair([&](size_t first, size_t second) {
+            REQUIRE(first != second);
+            REQUIRE(pairs.emplace(std::min(first, second), std::max(first, second)).second);
+        });
+
+        size_t overlapping = 0;
+        for (size_t i = 0; i < balls.size(); ++i)
+            for (size_t j = i + 1; j < balls.size(); ++j)
+                if (balls[i].DidCollide(balls[j])) {
+                    ++overlapping;
+                    REQUIRE(pairs.count({ i, j }) == 1);
+                }
+        CHECK(overlapping > 0);
+        // Candidates are a small part of all pairs
+        CHECK(pairs.size() < balls.size() * balls.size() / 20);
+    };
+
+    // Some balls sit past the bounds of the grid, they share the border cells
+    std::vector<BallCollider> balls;
+    for (unsigned i = 0; i < 400; ++i)
+        balls.emplace_back(Vector<3>{ coordinate(e), 1.f, coordinate(e) }, Vector<3>(), size(e));
+    checkPairs(balls);
+    CHECK(grid.CellSize() >= 3.f);
+    CHECK(grid.Columns() == 13);
+
+    // Rebuilt for balls that moved and shrunk
+    balls.clear();
+    for (unsigned i = 0; i < 400; ++i)
+        balls.emplace_back(Vector<3>{ coordinate(e), 1.f, coordinate(e) }, Vector<3>(), 1.f);
+    checkPairs(balls);
+    CHECK(grid.Columns() == 20);
+
+    std::vector<PlanarBallCollider> planar;
+    grid.Build(planar);
+    grid.ForEachPair([](size_t, size_t) { FAIL("No pairs expected"); });
+    planar.emplace_back(Vector<2>(), Vector<2>(), 1.f);
+    grid.Build(planar);
+    grid.ForEachPair([](size_t, size_t) { FAIL("No pairs expected"); });
+}
+
+TEST_CASE("Polar index broad phase") {
+    std::default_random_engine e(11);
+    std::uniform_real_distribution<float> angle(-pi, pi);
+    std::uniform_real_distribution<float> distance(0.f, 35.f);
+
+    // Three rings like the arena, bricks of different widths all around
+    std::vector<std::unique_ptr<BrickCollider>> colliders;
+    for (unsigned i = 0; i < 60; ++i) {
+        const float radii[] = { BRICK_DISTANCE, 20.f, PAD_DISTANCE };
+        colliders.push_back(std::make_unique<BrickCollider>(radii[i % 3], 1 + i % 7, angle(e)));
+    }
+    PolarIndex index{ SEGMENTS };
+    for (auto& collider : colliders)
+        index.Add(*collider);
+    REQUIRE(index.Size() == colliders.size());
+    REQUIRE(index.RingCount() == 3);
+
+    // Everything a ball overlaps is reported, each collider at most once
+    const auto checkQueries = [&] {
+        size_t reported = 0;
+        for (unsigned i = 0; i < 300; ++i) {
+            const auto ball = PlanarBallCollider{ Vector<2>(Vector<3>{ distance(e), 0.f, 0.f }.Rotate(angle(e), { 0.f, 1.f, 0.f }).To2()), Vector<2>(), 1.f };
+            std::set<const BrickCollider*> near;
+            index.ForEachNear(ball, [&](BrickCollider& collider) { REQUIRE(near.insert(&collider).second); });
+            reported += near.size();
+
+            size_t live = 0;
+            for (const auto& collider : colliders) {
+                live += near.count(collider.get());
+                if (Overlaps(Sphere<2>{ ball.Position(), ball.Radius }, collider->Sector()))
+                    REQUIRE(near.count(collider.get()) == 1);
+            }
+            REQUIRE(live == near.size());
+        }
+        // Candidates are a small part of all colliders
+        CHECK(reported < 300 * colliders.size() / 4);
+    };
+    checkQueries();
+
+    // Rotations move colliders across sectors and past the wraparound
+    for (unsigned step = 0; step < 40; ++step) {
+        for (auto& collider : colliders) {
+            collider->Rotate(0.13f);
+            index.Update(*collider);
+        }
+    }
+    checkQueries();
+
+    // Removed colliders are never reported, removed slots are reused
+    for (size_t i = 0; i < colliders.size(); i += 2) {
+        colliders[i]->ShouldBeDeleted = true;
+        index.Remove(*colliders[i]);
+    }
+    // Removing twice is harmless
+    index.Remove(*colliders[0]);
+    CHECK(index.Size() == colliders.size() / 2);
+    colliders.erase(std::remove_if(colliders.begin(), colliders.end(), [](const auto& collider) { return collider->ShouldBeDeleted; }), colliders.end());
+    colliders.push_back(std::make_unique<BrickCollider>(20.f, 36, 0.f));
+    index.Add(*colliders.back());
+    checkQueries();
+
+    // A ball sitting on the origin is inside the reach of every sector of a ring
+    BrickCollider around{ 0.5f, 3, 1.f };
+    index.Add(around);
+    bool found = false;
+    index.ForEachNear(Vector<2>(), Angle(), 1.f, [&](BrickCollider& collider) { found |= &collider == &around; });
+    CHECK(found);
+
+    // Damped to 90 after moving by 100, the only brick is right after where the step started and far out of
+    // reach of the velocity around the end
+    PolarIndex pathIndex{ SEGMENTS };
+    BrickCollider passed{ 5.f, 3, pi / 12.f };
+    pathIndex.Add(passed);
+    BallCollider damped{ Vector<3>{ 2.f, 1.f, 0.f }, Vector<3>{ 100.f, 0.f, 0.f }, 0.5f, 1.f };
+    damped.Step();
+    REQUIRE(damped.Velocity().X() == Approx(90.f));
+    REQUIRE(Sweep(Sphere<2>{ damped.Start().To2(), damped.Radius }, (damped.Position() - damped.Start()).To2(), passed.Sector()));
+    found = false;
+    pathIndex.ForEachNear(damped, [&](BrickCollider& collider) { found |= &collider == &passed; });
+    CHECK(found);
+}
+
+TEST_CASE("Angular sweep and prune") {
+    std::default_random_engine e(13);
+    std::uniform_real_distribution<float> angle(-pi, pi);
+    std::uniform_real_distribution<float> distance(0.f, 35.f);
+
+    std::vector<std::unique_ptr<BrickCollider>> colliders;
+    for (unsigned i = 0; i < 40; ++i) {
+        const float radii[] = { BRICK_DISTANCE, PAD_DISTANCE };
+        colliders.push_back(std::make_unique<BrickCollider>(radii[i % 2], 1 + i % 9, angle(e)));
+    }
+    // Starts exactly on the wraparound
+    colliders.push_back(std::make_unique<BrickCollider>(BRICK_DISTANCE, 3, pi));
+    AngularSweep sweep;
+    for (auto& collider : colliders)
+        sweep.Add(*collider);
+
+    std::vector<BallCollider> balls;
+    const auto respawn = [&](size_t count) {
+        balls.clear();
+        for (size_t i = 0; i < count; ++i)
+            balls.emplace_back(Vector<3>(Vector<3>{ distance(e), 1.f, 0.f }.Rotate(angle(e), { 0.f, 1.f, 0.f })), Vector<3>(), 1.f);
+        // Right on both sides of -pi
+        balls.emplace_back(Vector<3>{ -BRICK_DISTANCE - 1.f, 1.f, 0.5f }, Vector<3>(), 1.f);
+        balls.emplace_back(Vector<3>{ -BRICK_DISTANCE - 1.f, 1.f, -0.5f }, Vector<3>(), 1.f);
+    };
+
+    // Reported pairs are exactly the ones whose arcs and radii overlap, and include everything that touches
+    const auto checkPairs = [&] {
+        sweep.Update(balls);
+        std::set<std::pair<size_t, const BrickCollider*>> pairs;
+        sweep.ForEachPair([&](size_t ball, BrickCollider& collider) { REQUIRE(pairs.emplace(ball, &collider).second); });
+
+        for (size_t i = 0; i < balls.size(); ++i) {
+            const auto magnitude = balls[i].Position().To2().Magnitude();
+            const auto spread = std::asin(balls[i].Radius / magnitude);
+            const AngleInterval arc{ balls[i].PositionAngle() - Angle(spread), 2.f * spread };
+            for (const auto& collider : colliders) {
+                const auto expected = magnitude - balls[i].Radius <= collider->OuterRadius() && magnitude + balls[i].Radius >= collider->InnerRadius() && arc.Overlaps(collider->Interval());
+                REQUIRE(pairs.count({ i, collider.get() }) == size_t(expected));
+                if (Overlaps(Sphere<2>{ balls[i].Position().To2(), balls[i].Radius }, collider->Sector()))
+                    REQUIRE(expected);
+            }
+        }
+        CHECK(pairs.size() > 0);
+    };
+
+    respawn(200);
+    checkPairs();
+
+    // Colliders turn across the wraparound, the balls move too
+    for (unsigned step = 0; step < 30; ++step) {
+        for (auto& collider : colliders)
+            collider->Rotate(0.21f);
+        respawn(150 + step);
+        checkPairs();
+    }
+
+    // Removed colliders are gone, added ones show up
+    for (size_t i = 0; i < colliders.size(); i += 3) {
+        colliders[i]->ShouldBeDeleted = true;
+        sweep.Remove(*colliders[i]);
+    }
+    colliders.erase(std::remove_if(colliders.begin(), colliders.end(), [](const auto& collider) { return collider->ShouldBeDeleted; }), colliders.end());
+    colliders.push_back(std::make_unique<BrickCollider>(20.f, 20, 2.f));
+    sweep.Add(*colliders.back());
+    CHECK(sweep.ColliderCount() == colliders.size());
+    respawn(100);
+    checkPairs();
+}
+
+TEST_CASE("AABB tree broad phase") {
+    std::default_random_engine e(17);
+    std::uniform_real_distribution<float> coordinate(-20.f, 20.f);
+    std::uniform_real_distribution<float> speed(-0.3f, 0.3f);
+    std::uniform_real_distribution<float> angle(-pi, pi);
+
+    // Balls, bricks and the bounds all live in the same tree
+    std::vector<BallCollider> balls;
+    balls.reserve(300);
+    for (unsigned i = 0; i < 300; ++i)
+        balls.emplace_back(Vector<3>{ coordinate(e), 1.f, coordinate(e) }, Vector<3>{ speed(e), 0.f, speed(e) }, 0.5f + 0.1f * (i % 5));
+    std::vector<std::unique_ptr<BrickCollider>> bricks;
+    for (unsigned i = 0; i < 30; ++i)
+        bricks.push_back(std::make_unique<BrickCollider>(BRICK_DISTANCE, 1 + i % 4, angle(e)));
+    BoundsCollider bounds{ RADIUS };
+
+    AABBTree tree{ 0.5f };
+    std::vector<AABBTree::Proxy> proxies;
+    for (auto& ball : balls)
+        proxies.push_back(tree.Insert(ball));
+    for (auto& brick : bricks)
+        proxies.push_back(tree.Insert(*brick));
+    proxies.push_back(tree.Insert(bounds));
+    REQUIRE(tree.Size() == proxies.size());
+
+    // Reported pairs are exactly the ones whose fat boxes overlap, fat boxes contain their colliders
+    const auto checkPairs = [&] {
+        std::set<std::pair<const Collider*, const Collider*>> pairs;
+        tree.ForEachPair([&](Collider& first, Collider& second) {
+            REQUIRE(&first != &second);
+            REQUIRE(pairs.emplace(std::min(&first, &second), std::max(&first, &second)).second);
+        });
+
+        size_t overlapping = 0;
+        for (size_t i = 0; i < proxies.size(); ++i) {
+            const auto& collider = tree.ColliderOf(proxies[i]);
+            REQUIRE(tree.FatBox(proxies[i]).Contains(Bounds(collider)));
+            for (size_t j = i + 1; j < proxies.size(); ++j) {
+                const auto& other = tree.ColliderOf(proxies[j]);
+                const auto expected = Overlaps(tree.FatBox(proxies[i]), tree.FatBox(proxies[j]));
+                REQUIRE(pairs.count({ std::min(&collider, &other), std::max(&collider, &other) }) == size_t(expected));
+            }
+        }
+        for (size_t i = 0; i < balls.size(); ++i)
+            for (size_t j = i + 1; j < balls.size(); ++j)
+                if (balls[i].DidCollide(balls[j])) {
+                    ++overlapping;
+                    REQUIRE(pairs.count({ std::min<const Collider*>(&balls[i], &balls[j]), std::max<const Collider*>(&balls[i], &balls[j]) }) == 1);
+                }
+        CHECK(overlapping > 0);
+        // Rotations keep the tree close to balanced
+        CHECK(tree.Height() <= 2 * static_cast<int>(std::log2(tree.Size())) + 2);
+    };
+    checkPairs();
+
+    // Small moves stay inside the fat boxes, larger ones reinsert
+    size_t reinserted = 0;
+    for (unsigned step = 0; step < 20; ++step) {
+        for (auto& ball : balls)
+            ball.Step();
+        for (auto& brick : bricks)
+            brick->Rotate(0.02f);
+        for (const auto proxy : proxies)
+            reinserted += tree.Update(proxy);
+        if (step == 0)
+            CHECK(reinserted == 0);
+        checkPairs();
+    }
+    CHECK(reinserted > 0);
+    CHECK(reinserted < 20 * proxies.size());
+
+    // The closest ball along the ray, fat boxes only decide which balls are looked at
+    for (unsigned i = 0; i < 50; ++i) {
+        const auto direction = angle(e);
+        const Ray<2> ray{ { coordinate(e), coordinate(e) }, { std::cos(direction), std::sin(direction) } };
+        std::optional<float> expected;
+        std::set<const Collider*> closest;
+        for (const auto& ball : balls) {
+            const auto t = RayCast(ray, Sphere<2>{ ball.Position().To2(), ball.Radius });
+            if (!t || *t > 15.f || (expected && *t > *expected))
+                continue;
+            // Rays starting inside overlapping balls hit several of them at 0
+            if (!expected || *t < *expected)
+                closest.clear();
+            expected = t;
+            closest.insert(&ball);
+        }
+
+        const auto hit = tree.RayCast(ray, 15.f, [&](Collider& collider) -> std::optional<float> {
+            const auto ball = dynamic_cast<BallCollider*>(&collider);
+            if (!ball)
+                return std::nullopt;
+            return RayCast(ray, Sphere<2>{ ball->Position().To2(), ball->Radius });
+        });
+        REQUIRE(hit.has_value() == expected.has_value());
+        if (hit) {
+            CHECK(hit->t == *expected);
+            CHECK(closest.count(hit->collider) == 1);
+        }
+    }
+
+    // Removed colliders are never reported, their nodes are reused
+    for (size_t i = 0; i < proxies.size(); i += 2)
+        tree.Remove(proxies[i]);
+    std::vector<AABBTree::Proxy> kept;
+    for (size_t i = 1; i < proxies.size(); i += 2)
+        kept.push_back(proxies[i]);
+    proxies = kept;
+    CHECK(tree.Size() == proxies.size());
+    for (size_t i = 0; i < balls.size(); i += 2)
+        proxies.push_back(tree.Insert(balls[i]));
+    checkPairs();
+
+    // Boxes given in place of the bounds, such as the path a ball moves along
+    AABBTree paths{ 0.f };
+    const auto path = paths.Insert(balls[0], AABB<2>{ { 0.f, 0.f }, { 4.f, 1.f } });
+    CHECK(paths.FatBox(path).max == Vector<2>{ 4.f, 1.f });
+    CHECK_FALSE(paths.Update(path, AABB<2>{ { 1.f, 0.f }, { 2.f, 1.f } }));
+    CHECK(paths.Update(path, AABB<2>{ { 5.f, 0.f }, { 6.f, 1.f } }));
+    CHECK(paths.FatBox(path).min == Vector<2>{ 5.f, 0.f });
+    paths.Clear();
+    CHECK(paths.Size() == 0);
+    CHECK(paths.Height() == -1);
+
+    AABBTree empty;
+    CHECK(empty.Height() == -1);
+    empty.ForEachPair([](Collider&, Collider&) { FAIL("No pairs expected"); });
+    CHECK(!empty.RayCast(Ray<2>{ {}, { 1.f, 0.f } }, 1.f, [](Collider&) { return std::optional<float>(0.f); }));
+}
+
+TEST_CASE("Contact queue") {
+    ContactQueue queue;
+    const auto step = [](auto& balls) {
+        for (auto& ball : balls)
+            ball.Step();
+    };
+
+    // Passed right through each other during the step, they met after a third of it and bounced back
+    std::vector<BallCollider> balls;
+    balls.emplace_back(Vector<3>{ -3.f, 1.f, 0.f }, Vector<3>{ 6.f, 0.f, 0.f }, 1.f, 10.f);
+    balls.emplace_back(Vector<3>{ 3.f, 1.f, 0.f }, Vector<3>{ -6.f, 0.f, 0.f }, 1.f, 10.f);
+    step(balls);
+    CHECK(queue.Resolve(balls) == 1);
+    CHECK(balls[0].Position().X() == Approx(-5.f));
+    CHECK(balls[0].Position().Y() == 1.f);
+    CHECK(balls[1].Position().X() == Approx(5.f));
+    CHECK(balls[0].Velocity().X() == Approx(-6.f));
+    CHECK(balls[1].Velocity().X() == Approx(6.f));
+
+    // The first ball stops at the second one, which was resting and then catches up with the third
+    balls.clear();
+    balls.emplace_back(Vector<3>{ -6.f, 1.f, 0.f }, Vector<3>{ 6.f, 0.f, 0.f }, 1.f, 10.f);
+    balls.emplace_back(Vector<3>{ 0.f, 1.f, 0.f }, Vector<3>(), 1.f, 10.f);
+    balls.emplace_back(Vector<3>{ 3.f, 1.f, 0.f }, Vector<3>(), 1.f, 10.f);
+    step(balls);
+    CHECK(queue.Resolve(balls) == 2);
+    CHECK(balls[0].Position().X() == Approx(-2.f));
+    CHECK(balls[1].Position().X() == Approx(1.f));
+    CHECK(balls[2].Position().X() == Approx(4.f));
+    CHECK(balls[0].Velocity().X() == Approx(0.f).margin(1e-5f));
+    CHECK(balls[1].Velocity().X() == Approx(0.f).margin(1e-5f));
+    CHECK(balls[2].Velocity().X() == Approx(6.f));
+
+    // Turned by a brick at its inner wall at 9.5 after 11/16 of the step, the first ball covers its path
+    // back at its full speed and reaches the resting one at 7.2 after 0.975 of the step
+    const BrickCollider brick{ 10.f, 3, pi / 12.f };
+    balls.clear();
+    balls.emplace_back(Vector<3>{ 4.f, 1.f, 0.f }, Vector<3>{ 8.f, 0.f, 0.f }, 0.5f, 10.f);
+    balls.emplace_back(Vector<3>{ 6.2f, 1.f, 0.f }, Vector<3>(), 0.5f, 10.f);
+    step(balls);
+    REQUIRE(balls[0].Collision(brick));
+    CHECK(balls[0].StartTime() == Approx(0.6875f));
+    CHECK(queue.Resolve(balls) == 1);
+    CHECK(balls[0].Position().X() == Approx(7.2f));
+    CHECK(balls[1].Position().X() == Approx(6.f));
+    CHECK(balls[1].Velocity().X() == Approx(-8.f));
+
+    // Sent back by the bounds to where it began the step, the first ball rests there until the second one
+    // reaches it after 5/6 of the step
+    balls.clear();
+    balls.emplace_back(Vector<3>{ 0.f, 1.f, 18.5f }, Vector<3>{ 0.f, 0.f, 2.f }, 0.5f, 10.f);
+    balls.emplace_back(Vector<3>{ 0.f, 1.f, 15.f }, Vector<3>{ 0.f, 0.f, 3.f }, 0.5f, 10.f);
+    step(balls);
+    balls[0].Collision(BoundsCollider{ 20.f });
+    REQUIRE(balls[0].Velocity().Z() == Approx(-2.f));
+    CHECK(queue.Resolve(balls) == 1);
+    CHECK(balls[0].Position().Z() == Approx(19.f));
+    CHECK(balls[1].Position().Z() == Approx(17.5f - 1.f / 3));
+    CHECK(balls[0].Velocity().Z() == Approx(3.f));
+    CHECK(balls[1].Velocity().Z() == Approx(-2.f));
+
+    // A crowd of balls that didn't overlap at the start of the step doesn't at its end either, and keeps its
+    // momentum and energy. Balls without contacts are left exactly where they were.
+    std::default_random_engine e(23);
+    std::uniform_real_distribution<float> coordinate(-18.f, 18.f);
+    std::uniform_real_distribution<float> speed(-1.5f, 1.5f);
+    std::vector<PlanarBallCollider> crowd;
+    while (crowd.size() < 150) {
+        const Vector<2> start{ coordinate(e), coordinate(e) };
+        const auto radius = 0.5f + 0.1f * (crowd.size() % 4);
+        if (std::any_of(crowd.begin(), crowd.end(), [&](const PlanarBallCollider& ball) {
+                return Vector<2>::Distance(ball.Position(), start) < ball.Radius + radius;
+            }))
+            continue;
+        const Vector<2> velocity{ speed(e), speed(e) };
+        crowd.emplace_back(Vector<2>(start), Vector<2>(velocity), radius, 10.f);
+    }
+    step(crowd);
+    const auto before = crowd;
+    const auto momentum = [](const std::vector<PlanarBallCollider>& balls) {
+        auto ret = Vector<2>();
+        for (const auto& ball : balls)
+            ret += ball.Velocity() * ball.Mass;
+        return ret;
+    };
+    const auto energy = [](const std::vector<PlanarBallCollider>& balls) {
+        auto ret = 0.f;
+        for (const auto& ball : balls)
+            ret += ball.Mass * ball.Velocity().MagnitudeSquared();
+        return ret;
+    };
+
+    const auto processed = queue.Resolve(crowd);
+    CHECK(processed > 10);
+    CHECK(Vector<2>::Distance(momentum(crowd), momentum(before)) < 1e-3f * energy(before));
+    CHECK(energy(crowd) == Approx(energy(before)).epsilon(1e-4f));
+    size_t untouched = 0;
+    for (size_t i = 0; i < crowd.size(); ++i) {
+        untouched += crowd[i].Position() == before[i].Position() && crowd[i].Velocity() == before[i].Velocity();
+        for (size_t j = i + 1; j < crowd.size(); ++j)
+            REQUIRE(Vector<2>::Distance(crowd[i].Position(), crowd[j].Position()) >= crowd[i].Radius + crowd[j].Radius - 1e-3f);
+    }
+    CHECK(untouched + 2 * processed >= crowd.size());
+
+    std::vector<PlanarBallCollider> empty;
+    CHECK(queue.Resolve(empty) == 0);
+}
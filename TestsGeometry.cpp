@@ -1,7 +1,10 @@
 #include "catch.hpp"
 
+#include <limits>
+#include <optional>
 #include <random>
 #include <type_traits>
+#include <vector>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 
@@ -37,15 +40,26 @@ float RandomFloat() {
     return rrd(e);
 }
 
+template <size_t Width>
+Matrix<Width> RandomIntegerMatrix() {
+    std::uniform_int_distribution<int> rid(-9, 9);
+    Matrix<Width> mat;
+    for (size_t j = 0; j < Width; ++j)
+        for (size_t i = 0; i < Width; ++i)
+            mat[i][j] = static_cast<float>(rid(e));
+    return mat;
+}
+
 Vector<3> ToVector(const glm::vec3& vec) {
     return { vec.x, vec.y, vec.z };
 }
 
+// Relative precision per component, margin is an absolute floor for components that cancel to near zero
 template <size_t Size>
-void REQUIRE_APPROX(const Vector<Size>& lhs, const Vector<Size>& rhs) {
-    REQUIRE(lhs.X() == Approx(rhs.X()).epsilon(0.001f));
-    REQUIRE(lhs.Y() == Approx(rhs.Y()).epsilon(0.001f));
-    REQUIRE(lhs.Z() == Approx(rhs.Z()).epsilon(0.001f));
+void REQUIRE_APPROX(const Vector<Size>& lhs, const Vector<Size>& rhs, float margin = 0.f) {
+    REQUIRE(lhs.X() == Approx(rhs.X()).epsilon(0.001f).margin(margin));
+    REQUIRE(lhs.Y() == Approx(rhs.Y()).epsilon(0.001f).margin(margin));
+    REQUIRE(lhs.Z() == Approx(rhs.Z()).epsilon(0.001f).margin(margin));
 }
 
 GLMOperators(2);
@@ -75,6 +89,32 @@ TEST_CASE("Vector") {
         CHECK(c.X() == 2.f);
         CHECK(c.Y() == 2.f);
         CHECK(c.Z() == 2.f);
+
+        // Wrong component counts are rejected at compile time
+        cons = std::is_constructible_v<Vector<3>, float, float>;
+        CHECK_FALSE(cons);
+        cons = std::is_constructible_v<Vector<3>, float, float, float, float>;
+        CHECK_FALSE(cons);
+
+        constexpr Vector<3> d{ 1.f, 2.f, 3.f };
+        static_assert(d.Y() == 2.f && d.To4()[3] == 1.f);
+    }
+
+    SECTION("Storage layout") {
+        CHECK(sizeof(Vector<3>) == 16);
+        CHECK(alignof(Vector<3>) == 16);
+        CHECK(sizeof(Vector<4>) == 16);
+        CHECK(alignof(Vector<4>) == 16);
+        CHECK(sizeof(Vector<2>) == 2 * sizeof(float));
+
+        // Padding lane of Vector<3> must never leak into results
+        Vector<3> a(5.f);
+        a[0] = 1.f;
+        a[1] = 2.f;
+        a[2] = 3.f;
+        CHECK(a == Vector<3>{ 1.f, 2.f, 3.f });
+        CHECK(Vector<3>::Dot(a, a) == 14.f);
+        CHECK(a.Magnitude() == std::sqrt(14.f));
     }
 
     SECTION("Copy ctor") {
@@ -112,6 +152,21 @@ TEST_CASE("Vector") {
         CHECK(b == Vector<3>{ 2.f, 4.f, 6.f });
     }
 
+    SECTION("Scalar arithmetic operators") {
+        const Vector<3> a{ 1.f, 2.f, 4.f };
+        CHECK(a + 1.f == Vector<3>{ 2.f, 3.f, 5.f });
+        CHECK(a - 1.f == Vector<3>{ 0.f, 1.f, 3.f });
+        CHECK(a * 2.f == Vector<3>{ 2.f, 4.f, 8.f });
+        CHECK(a / 2.f == Vector<3>{ 0.5f, 1.f, 2.f });
+        CHECK(1.f + a == Vector<3>{ 2.f, 3.f, 5.f });
+        CHECK(2.f * a == Vector<3>{ 2.f, 4.f, 8.f });
+        // The scalar is the left operand of every element, these used to compute a - 1 and a / 8
+        CHECK(1.f - a == Vector<3>{ 0.f, -1.f, -3.f });
+        CHECK(8.f / a == Vector<3>{ 8.f, 4.f, 2.f });
+        CHECK(1.f - Vector<2>{ 3.f, -1.f } == Vector<2>{ -2.f, 2.f });
+        CHECK(8.f / Vector<4>{ 1.f, 2.f, 4.f, -8.f } == Vector<4>{ 8.f, 4.f, 2.f, -1.f });
+    }
+
     SECTION("Magnitude") {
         CHECK(Vector<3>().Magnitude() == 0.f);
         Vector<3> a{ 1.f, 2.f, 3.f };
@@ -128,7 +183,22 @@ TEST_CASE("Vector") {
             float y = RandomFloat();
             float z = RandomFloat();
             REQUIRE(Vector<3>{ x, y, z }.Magnitude() == mag(x, y, z));
+            REQUIRE(Vector<3>{ x, y, z }.MagnitudeSquared() == x * x + y * y + z * z);
         }
+
+        CHECK(a.MagnitudeSquared() == 14.f);
+        CHECK(Vector<2>{ 3.f, 4.f }.MagnitudeSquared() == 25.f);
+        CHECK(Vector<3>::DistanceSquared(a, b) == 8.f);
+        CHECK(Vector<3>::DistanceSquared(a, b) == Approx(Vector<3>::Distance(a, b) * Vector<3>::Distance(a, b)));
+    }
+
+    SECTION("Componentwise minimum and maximum") {
+        const Vector<3> a{ 1.f, -2.f, 3.f };
+        const Vector<3> b{ 0.f, 5.f, 3.f };
+        CHECK(Vector<3>::Min(a, b) == Vector<3>{ 0.f, -2.f, 3.f });
+        CHECK(Vector<3>::Max(a, b) == Vector<3>{ 1.f, 5.f, 3.f });
+        CHECK(Vector<2>::Min({ 1.f, 2.f }, { 2.f, 1.f }) == Vector<2>{ 1.f, 1.f });
+        CHECK(Vector<4, double>::Max({ 1.0, 2.0, 3.0, 4.0 }, Vector<4, double>(2.5)) == Vector<4, double>{ 2.5, 2.5, 3.0, 4.0 });
     }
 
     SECTION("Normalization") {
@@ -138,6 +208,8 @@ TEST_CASE("Vector") {
         Vector<3> b = Vector<3>::Normalized(a);
         CHECK(a.Normalize() == b);
 
+        // Fast math turns Normalize into NormalizeFast, which has its own section
+#ifndef GEOMETRY_FAST_MATH
         auto norm = [](float x, float y, float z) {
             float mag = std::sqrt(x * x + y * y + z * z);
             if (mag == 0.f)
@@ -151,6 +223,27 @@ TEST_CASE("Vector") {
             float z = RandomFloat();
             REQUIRE(Vector<3>{ x, y, z }.Normalize() == norm(x, y, z));
         }
+#endif
+    }
+
+    SECTION("Fast normalization") {
+        CHECK(Vector<3>().NormalizeFast() == Vector<3>());
+        CHECK(Vector<2>().NormalizeFast() == Vector<2>());
+
+        for (unsigned i = 0; i < 1000; ++i) {
+            const Vector<3> a{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const auto fast = Vector<3>::NormalizedFast(a);
+            const auto exact = Vector<3>::Normalized(a);
+            REQUIRE(fast.Magnitude() == Approx(1.f).epsilon(1e-6f));
+            for (size_t j = 0; j < 3; ++j)
+                REQUIRE(fast[j] == Approx(exact[j]).margin(1e-6f));
+
+            const Vector<2> b{ RandomFloat(), RandomFloat() };
+            REQUIRE(Vector<2>::NormalizedFast(b).Magnitude() == Approx(1.f).epsilon(1e-6f));
+        }
+
+        const Vector<3, double> c{ 2.0, 1.0, 6.0 };
+        CHECK(Vector<3, double>::NormalizedFast(c).Magnitude() == Approx(1.0));
     }
 
     SECTION("Invert") {
@@ -246,27 +339,75 @@ TEST_CASE("Matrix") {
         cons = std::is_constructible_v<Matrix<3>, float>;
         REQUIRE(cons);
 
-        cons = std::is_constructible_v<Matrix<3>, std::initializer_list<float>>;
+        cons = std::is_constructible_v<Matrix<3>, float, float, float, float, float, float, float, float, float>;
         REQUIRE(cons);
 
-        CHECK(Matrix<3>() == std::initializer_list<float>{ 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f });
-        CHECK(Matrix<3>(1.f) == std::initializer_list<float>{ 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f });
+        // Wrong element counts are rejected at compile time
+        cons = std::is_constructible_v<Matrix<3>, float, float>;
+        CHECK_FALSE(cons);
+        cons = std::is_constructible_v<Matrix<3>, float, float, float, float, float, float, float, float, float, float>;
+        CHECK_FALSE(cons);
+
+        CHECK(Matrix<3>() == Matrix<3>({ 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f }));
+        CHECK(Matrix<3>(1.f) == Matrix<3>({ 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f }));
 
         Matrix<3> a = {
             1.f, 2.f, 3.f,
             4.f, 5.f, 6.f,
             7.f, 8.f, 9.f
         };
-        CHECK(a == std::initializer_list<float>{ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f });
+        CHECK(a == Matrix<3>({ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f }));
 
         Matrix<3> b = a;
-        CHECK(b == std::initializer_list<float>{ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f });
+        CHECK(b == Matrix<3>({ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f }));
 
         Matrix<3> c(b);
-        CHECK(c == std::initializer_list<float>{ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f });
+        CHECK(c == Matrix<3>({ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f }));
+    }
+
+    SECTION("Double precision") {
+        for (unsigned n = 0; n < 20; ++n) {
+            const auto single = RandomIntegerMatrix<4>();
+            Matrix<4, double> mat;
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 4; ++i)
+                    mat[i][j] = single[i][j];
+
+            REQUIRE(mat.Determinant() == Approx(single.Determinant()));
+            if (mat.Determinant() == 0.0)
+                continue;
+            const auto identity = Matrix<4, double>::Inverted(mat) * mat;
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 4; ++i)
+                    REQUIRE(identity[i][j] == Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+        }
+
+        const auto rotation = Matrix<4, double>::Identity().Rotate(0.3, { 0.0, 1.0, 0.0 });
+        const auto expected = Matrix<4>::Identity().Rotate(0.3f, { 0.f, 1.f, 0.f });
+        for (size_t j = 0; j < 4; ++j)
+            for (size_t i = 0; i < 4; ++i)
+                REQUIRE(rotation[i][j] == Approx(expected[i][j]).margin(0.0001f));
+        CHECK(Vector<4, double>{ 1.0, 2.0, 3.0, 1.0 } * Matrix<4, double>::Identity().Translate({ 1.0, 0.0, 0.0 }) == Vector<4, double>{ 1.0, 2.0, 3.0, 2.0 });
+    }
 
-        CHECK_THROWS_WITH(Matrix<3>({ 1.f, 1.f }), "Can't initialize with list of size 2. Size must be 9.");
-        CHECK_THROWS_WITH(Matrix<3>({ 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f }), "Can't initialize with list of size 10. Size must be 9.");
+    SECTION("Compile time evaluation") {
+        constexpr Matrix<3> a = {
+            1.f, 2.f, 3.f,
+            4.f, 5.f, 6.f,
+            7.f, 8.f, 9.f
+        };
+        static_assert(a[2][1] == 6.f);
+
+        constexpr auto identity = Matrix<4>::Identity();
+        static_assert(identity[0][0] == 1.f && identity[1][0] == 0.f && identity[3][3] == 1.f);
+
+        constexpr auto ortho = Ortho(0.f, 800.f, 0.f, 600.f, -1.f, 1.f);
+        static_assert(ortho[0][0] == 2.f / 800.f);
+
+        for (auto angle : { -7.f, -pi, -1.f, 0.f, 0.3f, pi / 2.f, 2.f, 10.f }) {
+            CHECK(Sin(angle) == Approx(std::sin(angle)).margin(1e-6f));
+            CHECK(Cos(angle) == Approx(std::cos(angle)).margin(1e-6f));
+        }
     }
 
     SECTION("Matrix arithmetic operators") {
@@ -304,7 +445,7 @@ TEST_CASE("Matrix") {
 
         a[2][0] = 0.f;
         CHECK(a[2][0] == 0.f);
-        CHECK(a == std::initializer_list<float>{ 1.f, 2.f, 0.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f });
+        CHECK(a == Matrix<3>({ 1.f, 2.f, 0.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f }));
     }
 
     SECTION("Matrix multiplication") {
@@ -323,6 +464,61 @@ TEST_CASE("Matrix") {
         CHECK(b * a == Matrix<3>({ 90.f, 114.f, 138.f, 54.f, 69.f, 84.f, 18.f, 24.f, 30.f }));
     }
 
+    SECTION("SIMD multiplication against the reference loop") {
+        // Triple loop through the index operators, as operator* was before the SIMD path
+        const auto reference = [](const Matrix<4>& lhs, const Matrix<4>& rhs) {
+            Matrix<4> out;
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 4; ++i) {
+                    auto sum = 0.f;
+                    for (size_t k = 0; k < 4; ++k)
+                        sum += lhs[k][j] * rhs[i][k];
+                    out[i][j] = sum;
+                }
+            return out;
+        };
+
+        for (unsigned n = 0; n < 100; ++n) {
+            Matrix<4> a, b;
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 4; ++i) {
+                    a[i][j] = RandomFloat();
+                    b[i][j] = RandomFloat();
+                }
+
+            REQUIRE(a * b == reference(a, b));
+            REQUIRE(Matrix<4>::TransposedMultiply(a, b) == reference(Matrix<4>::Transposed(a), b));
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 4; ++i)
+                    REQUIRE(Matrix<4>::Transposed(a)[i][j] == a[j][i]);
+        }
+
+        Matrix<3> a = {
+            1.f, 2.f, 3.f,
+            4.f, 5.f, 6.f,
+            7.f, 8.f, 9.f
+        };
+        CHECK(Matrix<3>::TransposedMultiply(a, a) == Matrix<3>::Transposed(a) * a);
+    }
+
+    SECTION("Raw accessors") {
+        Matrix<4> a = {
+            1.f, 2.f, 3.f, 4.f,
+            5.f, 6.f, 7.f, 8.f,
+            9.f, 10.f, 11.f, 12.f,
+            13.f, 14.f, 15.f, 16.f
+        };
+        CHECK(a.At(1, 2) == 7.f);
+        CHECK(a.At(1, 2) == a[2][1]);
+        CHECK(a.RowData(2)[3] == 12.f);
+        CHECK(a.Column(1) == Vector<4>{ 2.f, 6.f, 10.f, 14.f });
+
+        a.At(3, 0) = -1.f;
+        CHECK(a[0][3] == -1.f);
+        a.RowData(0)[1] = -2.f;
+        CHECK(a[1][0] == -2.f);
+    }
+
     SECTION("Identity matrix") {
         CHECK(Matrix<3>::Identity() == glm::mat3(1.f));
         CHECK(Matrix<4>::Identity() == glm::mat4(1.f));
@@ -458,6 +654,167 @@ TEST_CASE("Matrix") {
         CHECK(c.Invert() == d);
     }
 
+    SECTION("Non-integer determinant") {
+        Matrix<2> a = {
+            .5f, .25f,
+            .75f, .5f
+        };
+        CHECK(a.Determinant() == .0625f);
+
+        Matrix<4> b = Matrix<4>::Identity() * .5f;
+        CHECK(b.Determinant() == .0625f);
+        CHECK(Matrix<4>::Inverted(b) == Matrix<4>::Identity() * 2.f);
+    }
+
+    SECTION("Closed form inverse against cofactor expansion") {
+        const auto cofactorDeterminant = [](const Matrix<4>& mat) {
+            float det = 0;
+            for (size_t i = 0; i < 4; ++i)
+                det += (i % 2 == 0 ? 1 : -1) * (&mat)[i] * mat.Minor(0, i).Determinant();
+            return det;
+        };
+
+        for (unsigned n = 0; n < 100; ++n) {
+            const auto mat = RandomIntegerMatrix<4>();
+
+            const auto det = cofactorDeterminant(mat);
+            REQUIRE(mat.Determinant() == det);
+            if (det == 0.f)
+                continue;
+
+            const auto expected = Matrix<4>::Minors(mat).Cofactor().Transpose() / det;
+            REQUIRE(Matrix<4>::Inverted(mat) == expected);
+        }
+    }
+
+    SECTION("Affine inverse") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const auto mat = Matrix<4>::Identity()
+                                 .Scale({ 1.f + std::abs(RandomFloat()), 1.f + std::abs(RandomFloat()), 1.f + std::abs(RandomFloat()) })
+                                 .Rotate(RandomFloat(), { RandomFloat(), RandomFloat(), RandomFloat() })
+                                 .Translate({ RandomFloat(), RandomFloat(), RandomFloat() });
+            const auto affine = Matrix<4>::InvertedAffine(mat);
+            const auto general = Matrix<4>::Inverted(mat);
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t k = 0; k < 4; ++k)
+                    REQUIRE(affine[j][k] == Approx(general[j][k]).margin(0.0001f));
+
+            const auto identity = affine * mat;
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t k = 0; k < 4; ++k)
+                    REQUIRE(identity[j][k] == Approx(j == k ? 1.f : 0.f).margin(0.0001f));
+        }
+
+        CHECK_THROWS_WITH(Matrix<3>::Identity().InvertAffine(), "Can't call InvertAffine on Matrix with dimension 3");
+    }
+
+    SECTION("LU decomposition") {
+        // Largest absolute row sum
+        const auto norm = [](const Matrix<5>& mat) {
+            auto ret = 0.f;
+            for (size_t i = 0; i < 5; ++i) {
+                auto sum = 0.f;
+                for (size_t j = 0; j < 5; ++j)
+                    sum += std::abs(mat[i][j]);
+                ret = std::max(ret, sum);
+            }
+            return ret;
+        };
+
+        for (unsigned n = 0; n < 20; ++n) {
+            const auto mat = RandomIntegerMatrix<5>();
+
+            // Exact, every partial sum of the integer expansion stays below 2^24
+            float cofactor = 0;
+            for (size_t i = 0; i < 5; ++i)
+                cofactor += (i % 2 == 0 ? 1 : -1) * mat[i][0] * mat.Minor(0, i).Determinant();
+            if (cofactor == 0.f)
+                continue;
+
+            // Partial pivoting is backward stable, relative errors stay below about 5 * FLT_EPSILON * cond(mat).
+            // Random integer matrices are often poorly conditioned, so a fixed tolerance is either too tight
+            // for those or meaningless for the rest.
+            const auto inverse = Matrix<5>::Inverted(mat);
+            const auto tolerance = 5.f * std::numeric_limits<float>::epsilon() * norm(mat) * norm(inverse);
+            REQUIRE(mat.Determinant() == Approx(cofactor).epsilon(tolerance));
+            REQUIRE(LUDecomposition<5>(mat).Determinant() == Approx(cofactor).epsilon(tolerance));
+
+            const auto identity = inverse * mat;
+            for (size_t j = 0; j < 5; ++j)
+                for (size_t i = 0; i < 5; ++i)
+                    REQUIRE(identity[i][j] == Approx(i == j ? 1.f : 0.f).margin(tolerance));
+        }
+
+        // Solution satisfies x * matrix == rhs
+        Matrix<4> a = {
+            1.f, 2.f, 3.f, 1.f,
+            3.f, 4.f, 5.f, 2.f,
+            2.f, 5.f, 4.f, 3.f,
+            1.f, 3.f, 2.f, 1.f
+        };
+        const auto x = a.Solve({ 1.f, 2.f, 3.f, 4.f });
+        const auto rhs = Vector<4>{ x[0], x[1], x[2], x[3] } * a;
+        CHECK(rhs[0] == Approx(1.f));
+        CHECK(rhs[1] == Approx(2.f));
+        CHECK(rhs[2] == Approx(3.f));
+        CHECK(rhs[3] == Approx(4.f));
+
+        Matrix<6> singular(1.f);
+        LUDecomposition<6> lu(singular);
+        CHECK(lu.IsSingular());
+        CHECK(lu.Determinant() == 0.f);
+        CHECK(singular.Determinant() == 0.f);
+
+        CHECK(LUDecomposition<6>(Matrix<6>::Identity() * 2.f).Determinant() == Approx(64.f));
+    }
+
+    SECTION("Batch transform") {
+        const auto mat = Matrix<4>::Identity()
+                             .Scale({ 1.f + std::abs(RandomFloat()), 1.f + std::abs(RandomFloat()), 1.f + std::abs(RandomFloat()) })
+                             .Rotate(RandomFloat(), { RandomFloat(), RandomFloat(), RandomFloat() })
+                             .Translate({ RandomFloat(), RandomFloat(), RandomFloat() });
+        // Enough elements to be split over several threads
+        std::vector<Vector<4>> vectors;
+        std::vector<Vector<3>> points;
+        for (unsigned i = 0; i < 5000; ++i) {
+            vectors.push_back({ RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat() });
+            points.push_back({ RandomFloat(), RandomFloat(), RandomFloat() });
+        }
+
+        // Same convention as the shader and Transform3::Apply
+        const auto transposed = Matrix<4>::Transposed(mat);
+        std::vector<Vector<4>> transformed(vectors.size());
+        mat.Transform(vectors.data(), vectors.size(), transformed.data(), 4);
+        for (size_t i = 0; i < vectors.size(); ++i)
+            REQUIRE(transformed[i] == vectors[i] * transposed);
+
+        auto inPlace = points;
+        mat.TransformPoints(inPlace.data(), inPlace.size(), inPlace.data(), 0);
+        for (size_t i = 0; i < points.size(); ++i)
+            REQUIRE(inPlace[i] == (Vector<4>{ points[i].X(), points[i].Y(), points[i].Z(), 1.f } * transposed).To3());
+
+        // Normals stay perpendicular to transformed tangents
+        const auto normalMatrix = Matrix<4>::Inverted(mat);
+        std::vector<Vector<3>> normals(points.size());
+        mat.TransformNormals(points.data(), points.size(), normals.data(), 4);
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto expected = Vector<3>::Normalized((Vector<4>{ points[i].X(), points[i].Y(), points[i].Z(), 0.f } * normalMatrix).To3());
+            for (size_t j = 0; j < 3; ++j)
+                REQUIRE(normals[i][j] == Approx(expected[j]).margin(0.0001f));
+
+            const auto tangent = Vector<3>::Cross(points[i], { 0.f, 1.f, 0.f });
+            const auto transformedTangent = (Vector<4>{ tangent.X(), tangent.Y(), tangent.Z(), 0.f } * transposed).To3();
+            REQUIRE(Vector<3>::Dot(normals[i], Vector<3>::Normalized(transformedTangent)) == Approx(0.f).margin(0.0001f));
+        }
+
+        const auto doubleMat = Matrix<4, double>::Identity().Translate({ 1.0, 2.0, 3.0 });
+        Vector<3, double> point[] = { { 1.0, 1.0, 1.0 } };
+        doubleMat.TransformPoints(point, 1, point);
+        CHECK(point[0] == Vector<3, double>{ 2.0, 3.0, 4.0 });
+
+        CHECK_THROWS_WITH(Matrix<3>::Identity().TransformPoints(nullptr, 0, nullptr), "Can't call TransformPoints on Matrix with dimension 3");
+    }
+
     SECTION("Perspective") {
         auto myMat = Perspective(45.f, 16.f / 9.f, 1.f, 100.f);
         glm::mat4 glmMat = glm::perspective(glm::radians(45.f), 16.f / 9.f, 1.f, 100.f);
@@ -477,6 +834,680 @@ TEST_CASE("Matrix") {
     }
 }
 
+TEST_CASE("Fixed") {
+    SECTION("Arithmetic") {
+        static_assert(Fixed(1.5f) * Fixed(2) == Fixed(3));
+        CHECK(static_cast<float>(Fixed(1.25f) + Fixed(2.5)) == 3.75f);
+        CHECK(static_cast<float>(Fixed(1.25f) - Fixed(2.5)) == -1.25f);
+        CHECK(static_cast<float>(Fixed(-1.5f) * Fixed(2.5f)) == -3.75f);
+        CHECK(static_cast<float>(Fixed(7) / Fixed(2)) == 3.5f);
+        CHECK(static_cast<float>(-Fixed(7) / Fixed(2)) == -3.5f);
+        CHECK(Fixed(1) / Fixed() == Fixed::FromRaw(std::numeric_limits<int32_t>::max()));
+        CHECK(Fixed(0.5f).Raw() == 1 << 15);
+        CHECK(Fixed(-3) < Fixed(2));
+        CHECK(abs(Fixed(-3)) == Fixed(3));
+
+        // Results out of range saturate instead of wrapping around
+        const auto max = Fixed::FromRaw(std::numeric_limits<int32_t>::max());
+        const auto min = Fixed::FromRaw(std::numeric_limits<int32_t>::min());
+        static_assert(Fixed(30000) + Fixed(30000) == Fixed::FromRaw(std::numeric_limits<int32_t>::max()));
+        CHECK(Fixed(-30000) - Fixed(30000) == min);
+        CHECK(Fixed(200) * Fixed(200) == max);
+        CHECK(Fixed(-200) * Fixed(200) == min);
+        CHECK(Fixed(20000) / Fixed(0.5f) == max);
+        CHECK(-min == max);
+        CHECK(abs(min) == max);
+        CHECK(Fixed(40000) == max);
+        CHECK(Fixed(-1e9) == min);
+        CHECK(Vector<3, Fixed>{ 150.f, 150.f, 0.f }.MagnitudeSquared() == max);
+    }
+
+    SECTION("Math functions") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const auto x = RandomFloat();
+            const auto y = RandomFloat();
+            CHECK(static_cast<float>(sqrt(Fixed(std::abs(x)))) == Approx(std::sqrt(std::abs(x))).margin(0.0001f));
+            CHECK(static_cast<float>(sin(Fixed(x))) == Approx(std::sin(static_cast<float>(Fixed(x)))).margin(0.0001f));
+            CHECK(static_cast<float>(cos(Fixed(x))) == Approx(std::cos(static_cast<float>(Fixed(x)))).margin(0.0001f));
+            CHECK(static_cast<float>(atan2(Fixed(y), Fixed(x))) == Approx(std::atan2(static_cast<float>(Fixed(y)), static_cast<float>(Fixed(x)))).margin(0.0001f));
+        }
+        CHECK(sqrt(Fixed(-1)) == Fixed());
+        CHECK(atan2(Fixed(), Fixed()) == Fixed());
+        CHECK(static_cast<float>(atan2(Fixed(), Fixed(-1))) == Approx(pi).margin(0.0001f));
+        CHECK(static_cast<float>(atan2(Fixed(-1), Fixed())) == Approx(-pi / 2.f).margin(0.0001f));
+    }
+
+    SECTION("Vector and Matrix instantiations") {
+        const Vector<3, Fixed> a{ 1.f, 2.f, 2.f };
+        CHECK(a.Magnitude() == Fixed(3));
+        CHECK(Vector<3, Fixed>::Cross(a, { 0.f, 0.f, 1.f }) == Vector<3, Fixed>{ 2.f, -1.f, 0.f });
+        CHECK(Vector<3, Fixed>::Normalized({ 0.f, 4.f, 0.f }) == Vector<3, Fixed>{ 0.f, 1.f, 0.f });
+
+        const auto rotated = Vector<3, Fixed>{ 1.f, 0.f, 0.f }.Rotate(Fixed(pi / 2.f), { 0.f, 1.f, 0.f });
+        CHECK(static_cast<float>(rotated.Z()) == Approx(-1.f).margin(0.001f));
+
+        const Matrix<3, Fixed> mat = {
+            2.f, 0.f, 0.f,
+            0.f, 4.f, 0.f,
+            1.f, 0.f, 1.f
+        };
+        CHECK(mat.Determinant() == Fixed(8));
+        CHECK(Matrix<3, Fixed>::Inverted(mat) * mat == Matrix<3, Fixed>::Identity());
+    }
+}
+
+TEST_CASE("Quaternion") {
+    // Random components reach 100 and rotated ones can cancel to near zero, where the relative check alone
+    // would ask for more precision than float has at that scale. 0.01 is 1e-4 of it.
+    constexpr auto margin = 0.01f;
+    const auto requireApproxMatrix = [](const Matrix<4>& lhs, const Matrix<4>& rhs) {
+        for (size_t j = 0; j < 4; ++j)
+            for (size_t i = 0; i < 4; ++i)
+                REQUIRE(lhs[i][j] == Approx(rhs[i][j]).margin(0.0001f));
+    };
+
+    SECTION("Rotation against Vector::Rotate") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const Vector<3> vec{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const Vector<3> axis{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const auto angle = RandomFloat();
+            const auto expected = Vector<3>(vec).Rotate(angle, axis);
+
+            const Rotation rotation(angle, axis);
+            REQUIRE_APPROX(rotation.Apply(vec), expected, margin);
+            REQUIRE_APPROX(Vector<3>(vec).Rotate(rotation), expected, margin);
+            REQUIRE_APPROX(Quaternion::FromAxisAngle(angle, axis).Rotate(vec), expected, margin);
+            REQUIRE_APPROX(Rotation::Inverted(rotation).Apply(expected), vec, margin);
+
+            const auto vec4 = Vector<4>{ vec.X(), vec.Y(), vec.Z(), 7.f }.Rotate(rotation);
+            REQUIRE_APPROX(Vector<3>{ vec4.X(), vec4.Y(), vec4.Z() }, expected, margin);
+            REQUIRE(vec4[3] == 7.f);
+        }
+    }
+
+    SECTION("Rotation around Y") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const Vector<3> vec{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const auto angle = RandomFloat();
+            const auto rotation = Rotation::AroundY(angle);
+            REQUIRE(rotation.Sin() == std::sin(angle));
+            REQUIRE(rotation.Cos() == std::cos(angle));
+            REQUIRE_APPROX(rotation.Apply(vec), ToVector(glm::rotate(glm::vec3(vec.X(), vec.Y(), vec.Z()), angle, glm::vec3(0.f, 1.f, 0.f))), margin);
+        }
+    }
+
+    SECTION("Conversion to matrix") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const Vector<3> axis{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const auto angle = RandomFloat();
+            const auto expected = Matrix<4>::Identity().Rotate(angle, axis);
+
+            requireApproxMatrix(Rotation(angle, axis).ToMatrix(), expected);
+            requireApproxMatrix(Quaternion::FromAxisAngle(angle, axis).ToMatrix(), expected);
+            requireApproxMatrix(Matrix<4>::Identity().Rotate(Rotation(angle, axis)), expected);
+        }
+
+        CHECK_THROWS_WITH(Matrix<3>::Identity().Rotate(Rotation()), "Can't call Rotate on Matrix with dimension 3");
+    }
+
+    SECTION("Composition") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const Vector<3> vec{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const Rotation first(RandomFloat(), { RandomFloat(), RandomFloat(), RandomFloat() });
+            const Rotation second(RandomFloat(), { RandomFloat(), RandomFloat(), RandomFloat() });
+            const auto expected = second.Apply(first.Apply(vec));
+
+            REQUIRE_APPROX((second * first).Apply(vec), expected, margin);
+            REQUIRE_APPROX((second.ToQuaternion() * first.ToQuaternion()).Rotate(vec), expected, margin);
+            REQUIRE_APPROX(Rotation(first.ToQuaternion()).Apply(vec), first.Apply(vec), margin);
+        }
+
+        CHECK(Quaternion() * Quaternion() == Quaternion());
+        CHECK(Rotation(Quaternion()).Angle() == 0.f);
+    }
+
+    SECTION("Slerp") {
+        const auto from = Quaternion::FromAxisAngle(0.2f, { 0.f, 1.f, 0.f });
+        const auto to = Quaternion::FromAxisAngle(1.4f, { 0.f, 1.f, 0.f });
+        const Vector<3> vec{ 1.f, 2.f, 3.f };
+
+        REQUIRE_APPROX(Quaternion::Slerp(from, to, 0.f).Rotate(vec), from.Rotate(vec));
+        REQUIRE_APPROX(Quaternion::Slerp(from, to, 1.f).Rotate(vec), to.Rotate(vec));
+        REQUIRE_APPROX(Quaternion::Slerp(from, to, 0.5f).Rotate(vec), Quaternion::FromAxisAngle(0.8f, { 0.f, 1.f, 0.f }).Rotate(vec));
+        // Shorter arc is taken for quaternions on opposite hemispheres
+        const auto negated = Quaternion(-to.W(), Vector<3>::Inverted(to.Imaginary()));
+        REQUIRE_APPROX(Quaternion::Slerp(from, negated, 0.25f).Rotate(vec), Quaternion::FromAxisAngle(0.5f, { 0.f, 1.f, 0.f }).Rotate(vec));
+        CHECK(Quaternion::Slerp(from, to, 0.3f).Magnitude() == Approx(1.f));
+    }
+}
+
+TEST_CASE("Transform3") {
+    const auto requireApproxMatrix = [](const Transform3& lhs, const Matrix<4>& rhs) {
+        const auto mat = lhs.ToMatrix();
+        for (size_t j = 0; j < 4; ++j)
+            for (size_t i = 0; i < 4; ++i)
+                REQUIRE(mat[i][j] == Approx(rhs[i][j]).margin(0.001f));
+        // Storage is handed to OpenGL directly and must match Matrix<4> layout
+        for (size_t i = 0; i < 16; ++i)
+            REQUIRE((&lhs)[i] == (&mat)[i]);
+    };
+
+    SECTION("Identity") {
+        CHECK(Transform3().ToMatrix() == Matrix<4>::Identity());
+    }
+
+    SECTION("Composition against Matrix<4>") {
+        for (unsigned i = 0; i < 100; ++i) {
+            const Vector<3> translation{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const Vector<3> scale{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const Vector<3> axis{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const auto angle = RandomFloat();
+
+            requireApproxMatrix(Transform3().Translate(translation), Matrix<4>::Identity().Translate(translation));
+            requireApproxMatrix(Transform3().RotateY(angle), Matrix<4>::Identity().Rotate(angle, { 0.f, 1.f, 0.f }));
+            requireApproxMatrix(Transform3().Scale(scale), Matrix<4>::Identity().Scale(scale));
+            requireApproxMatrix(Transform3().Scale(scale).Rotate(Rotation(angle, axis)).Translate(translation),
+                                Matrix<4>::Identity().Scale(scale).Rotate(angle, axis).Translate(translation));
+            requireApproxMatrix(Transform3().RotateY(angle).Translate(translation).Scale(scale),
+                                Matrix<4>::Identity().Rotate(angle, { 0.f, 1.f, 0.f }).Translate(translation).Scale(scale));
+
+            const auto lhs = Transform3().RotateY(angle).Translate(translation);
+            const auto rhs = Transform3().Scale(scale).Rotate(Rotation(angle, axis));
+            requireApproxMatrix(lhs * rhs, lhs.ToMatrix() * rhs.ToMatrix());
+        }
+    }
+
+    SECTION("Point transformation") {
+        // Points and translations reach 100 per component and can sum to near zero, same margin as the
+        // Quaternion tests
+        constexpr auto margin = 0.01f;
+        for (unsigned i = 0; i < 100; ++i) {
+            const Vector<3> point{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const Vector<3> translation{ RandomFloat(), RandomFloat(), RandomFloat() };
+            const auto angle = RandomFloat();
+            const auto transform = Transform3().RotateY(angle).Translate(translation);
+            const auto expected = point.To4() * Matrix<4>::Transposed(transform.ToMatrix());
+
+            REQUIRE_APPROX(transform.Apply(point), Vector<3>{ expected.X(), expected.Y(), expected.Z() }, margin);
+            REQUIRE_APPROX(transform.Apply(point), Vector<3>(point).Rotate(angle, { 0.f, 1.f, 0.f }) + translation, margin);
+        }
+    }
+}
+
+TEST_CASE("VectorArray") {
+    std::vector<Vector<3>> lhs, rhs;
+    VectorArray<3> lhsArray, rhsArray;
+    for (unsigned i = 0; i < 37; ++i) {
+        lhs.push_back({ RandomFloat(), RandomFloat(), RandomFloat() });
+        rhs.push_back({ RandomFloat(), RandomFloat(), RandomFloat() });
+        lhsArray.PushBack(lhs.back());
+        rhsArray.PushBack(rhs.back());
+    }
+    lhs.push_back(Vector<3>());
+    rhs.push_back(Vector<3>());
+    lhsArray.PushBack(Vector<3>());
+    rhsArray.PushBack(Vector<3>());
+    std::vector<float> out(lhs.size());
+
+    SECTION("Element access") {
+        REQUIRE(lhsArray.Count() == lhs.size());
+        for (size_t i = 0; i < lhs.size(); ++i)
+            REQUIRE(lhsArray.Get(i) == lhs[i]);
+
+        lhsArray.Set(3, { 1.f, 2.f, 3.f });
+        CHECK(lhsArray.Get(3) == Vector<3>{ 1.f, 2.f, 3.f });
+        CHECK(lhsArray.Lane(1)[3] == 2.f);
+        CHECK(VectorArray<2>(4, { 1.f, 2.f }).Get(3) == Vector<2>{ 1.f, 2.f });
+    }
+
+    SECTION("Kernels match Vector") {
+        VectorArray<3>::Dot(lhsArray, rhsArray, out.data());
+        for (size_t i = 0; i < lhs.size(); ++i)
+            REQUIRE(out[i] == Vector<3>::Dot(lhs[i], rhs[i]));
+
+        VectorArray<3>::Distances(lhsArray, rhsArray, out.data());
+        for (size_t i = 0; i < lhs.size(); ++i)
+            REQUIRE(out[i] == Vector<3>::Distance(lhs[i], rhs[i]));
+
+        VectorArray<3>::Distances(lhsArray, rhs[0], out.data());
+        for (size_t i = 0; i < lhs.size(); ++i)
+            REQUIRE(out[i] == Vector<3>::Distance(lhs[i], rhs[0]));
+
+        lhsArray.Magnitudes(out.data());
+        for (size_t i = 0; i < lhs.size(); ++i)
+            REQUIRE(out[i] == lhs[i].Magnitude());
+
+        auto axpy = lhsArray;
+        axpy.Axpy(0.5f, rhsArray).Scale(2.f);
+        auto normalized = lhsArray;
+        normalized.Normalize();
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            REQUIRE(axpy.Get(i) == (lhs[i] + rhs[i] * 0.5f) * 2.f);
+            REQUIRE(normalized.Get(i) == Vector<3>::Normalized(lhs[i]));
+        }
+    }
+
+        SECTION("Polar coordinates") {
+        std::vector<float> radii(lhs.size());
+        std::vector<float> angles(lhs.size());
+        lhsArray.Polar(radii.data(), angles.data());
+        std::vector<float> anglesOnly(lhs.size());
+        lhsArray.Polar(nullptr, anglesOnly.data());
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            REQUIRE(radii[i] == lhs[i].To2().Magnitude());
+            REQUIRE(angles[i] == Atan2(lhs[i].Z(), lhs[i].X()));
+            REQUIRE(anglesOnly[i] == angles[i]);
+        }
+    }
+
+SECTION("Magnitude limits") {
+        auto clamped = lhsArray;
+        clamped.ClampMagnitude(10.f);
+        const std::vector<float> limits(lhs.size(), 10.f);
+        auto scaled = lhsArray;
+        scaled.ScaleAbove(limits.data(), 0.9f);
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            const auto magnitude = lhs[i].Magnitude();
+            REQUIRE(clamped.Get(i).Magnitude() == Approx(std::min(magnitude, 10.f)));
+            REQUIRE(scaled.Get(i) == (magnitude > 10.f ? lhs[i] * 0.9f : lhs[i]));
+        }
+    }
+}
+
+TEST_CASE("Expression") {
+    for (unsigned i = 0; i < 100; ++i) {
+        const Vector<2> velocity{ RandomFloat(), RandomFloat() };
+        const auto normal = Vector<2>::Normalized({ RandomFloat(), RandomFloat() });
+        const Vector<3> position{ RandomFloat(), RandomFloat(), RandomFloat() };
+        const Vector<3> corner{ RandomFloat(), RandomFloat(), RandomFloat() };
+        const auto scalar = RandomFloat();
+
+        // Same operations in the same order give bit identical results
+        const Vector<2> reflected = 2.f * Vector<2>::Dot(velocity, normal) * Lazy(normal) - Lazy(velocity);
+        REQUIRE(reflected == 2.f * Vector<2>::Dot(velocity, normal) * normal - velocity);
+
+        const Vector<3> moved = Lazy(position) + (Lazy(position) - Lazy(corner)) * scalar / 3.f;
+        REQUIRE(moved == position + (position - corner) * scalar / 3.f);
+
+        REQUIRE((Lazy(position) * Lazy(corner) + 1.f).Eval() == position * corner + 1.f);
+        REQUIRE((1.f - Lazy(position) / Lazy(corner)).Eval() == 1.f - position / corner);
+        REQUIRE((scalar / Lazy(position) - scalar).Eval() == scalar / position - scalar);
+    }
+
+    auto accumulated = Vector<3>(1.f);
+    const Vector<3> step{ 1.f, 2.f, 3.f };
+    accumulated += Lazy(step) * 2.f;
+    CHECK(accumulated == Vector<3>{ 3.f, 5.f, 7.f });
+}
+
+TEST_CASE("Trigonometry") {
+    SECTION("SinCos error bound") {
+        for (auto angle = -100.f; angle < 100.f; angle += 0.01f) {
+            const auto sineCosine = SinCos(angle);
+            REQUIRE(std::abs(sineCosine.sine - std::sin(static_cast<double>(angle))) < 1.2e-7);
+            REQUIRE(std::abs(sineCosine.cosine - std::cos(static_cast<double>(angle))) < 1.2e-7);
+        }
+        for (unsigned i = 0; i < 1000; ++i) {
+            const auto angle = RandomFloat() * 80.f;
+            REQUIRE(std::abs(SinCos(angle).sine - std::sin(static_cast<double>(angle))) < 1.2e-7);
+        }
+        const auto sum = SinCosSum(SinCos(1.f), SinCos(2.f));
+        CHECK(sum.sine == Approx(std::sin(3.f)).margin(1e-6f));
+        CHECK(sum.cosine == Approx(std::cos(3.f)).margin(1e-6f));
+    }
+
+    SECTION("Atan2 error bound") {
+        for (unsigned i = 0; i < 10000; ++i) {
+            const auto y = RandomFloat();
+            const auto x = RandomFloat();
+            REQUIRE(std::abs(Atan2(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x))) < 3.5e-7);
+        }
+        CHECK(Atan2(0.f, 0.f) == 0.f);
+        CHECK(Atan2(1.f, 0.f) == pi / 2);
+        CHECK(Atan2(-1.f, 0.f) == -pi / 2);
+        CHECK(Atan2(0.f, -1.f) == pi);
+        CHECK(Atan2(0.f, 1.f) == 0.f);
+    }
+
+    SECTION("Span kernels against the scalar functions") {
+        // Odd count so the scalar tail runs too
+        std::vector<float> x(1003);
+        std::vector<float> y(x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            x[i] = RandomFloat();
+            y[i] = RandomFloat();
+        }
+        const float special[] = { 0.f, -0.f, 1.f, -1.f, 1e-30f, -8192.f };
+        for (size_t i = 0; i < 6; ++i)
+            for (size_t j = 0; j < 6; ++j) {
+                x.push_back(special[i]);
+                y.push_back(special[j]);
+            }
+
+        std::vector<float> sines(x.size());
+        std::vector<float> cosines(x.size());
+        std::vector<float> angles(x.size());
+        std::vector<float> roots(x.size());
+        std::vector<float> squares(x.size());
+        for (size_t i = 0; i < x.size(); ++i)
+            squares[i] = y[i] * y[i];
+        SinCos(x.data(), x.size(), sines.data(), cosines.data());
+        Atan2(y.data(), x.data(), x.size(), angles.data());
+        Sqrt(squares.data(), squares.size(), roots.data());
+        for (size_t i = 0; i < x.size(); ++i) {
+            const auto sineCosine = SinCos(x[i]);
+            REQUIRE(sines[i] == sineCosine.sine);
+            REQUIRE(cosines[i] == sineCosine.cosine);
+            REQUIRE(angles[i] == Atan2(y[i], x[i]));
+            REQUIRE(roots[i] == std::sqrt(squares[i]));
+        }
+    }
+
+    SECTION("Angle table rotation") {
+        const float step = -2 * pi / 36;
+        const AngleTable table(step, 37);
+        REQUIRE(table.Count() == 37);
+
+        const Vector<2> points[] = { { 10.f, 0.f }, { 13.f, 2.f }, { -4.f, 7.f } };
+        Vector<2> out[3];
+        for (size_t k = 0; k < table.Count(); ++k) {
+            table.Rotate(points, 3, k, out);
+            for (size_t i = 0; i < 3; ++i) {
+                REQUIRE(out[i] == table.Rotate(points[i], k));
+                // Same direction as Vector::Rotate around -Y in the XZ plane
+                const auto expected = Vector<3>{ points[i][0], 0.f, points[i][1] }.Rotate(static_cast<float>(k) * step, { 0.f, -1.f, 0.f });
+                REQUIRE(out[i][0] == Approx(expected.X()).margin(1e-5f));
+                REQUIRE(out[i][1] == Approx(expected.Z()).margin(1e-5f));
+            }
+        }
+        CHECK(table.Rotate({ 1.f, 0.f }, 36)[0] == Approx(1.f));
+        CHECK(table.Rotate({ 1.f, 0.f }, 36)[1] == Approx(0.f).margin(1e-6f));
+    }
+}
+
+TEST_CASE("Angle") {
+    SECTION("Wrapping") {
+        for (auto radians = -50.f; radians < 50.f; radians += 0.01f) {
+            const auto wrapped = Angle(radians).Radians();
+            REQUIRE(wrapped >= -pi);
+            REQUIRE(wrapped <= pi);
+            REQUIRE(std::abs(std::remainder(static_cast<double>(wrapped) - radians, 2 * 3.14159265358979323846)) < 1e-5);
+        }
+        CHECK(Angle(0.5f).Radians() == 0.5f);
+        CHECK(Angle(3 * pi / 2).Radians() == Approx(-pi / 2));
+        CHECK((Angle(3.f) + Angle(1.f)).Radians() == Approx(4.f - 2 * pi));
+        CHECK((Angle(-3.f) - Angle(1.f)).Radians() == Approx(2 * pi - 4.f));
+        CHECK((-Angle(pi / 2)).Radians() == Approx(-pi / 2));
+        CHECK(std::abs(Angle::Polar({ -1.f, 0.f }).Radians()) == Approx(pi));
+        CHECK(Angle::Polar({ 0.f, -2.f }).Radians() == Approx(-pi / 2));
+    }
+
+    SECTION("Interval across the wraparound") {
+        const AngleInterval interval(Angle(pi - 0.2f), 0.5f);
+        CHECK(interval.To().Radians() == Approx(-pi + 0.3f));
+        CHECK(interval.Middle().Radians() == Approx(-pi + 0.05f));
+        CHECK(interval.Contains(Angle(pi)));
+        CHECK(interval.Contains(Angle(-pi + 0.1f)));
+        CHECK(interval.Contains(Angle(pi - 0.1f)));
+        CHECK_FALSE(interval.Contains(Angle(0.f)));
+        CHECK_FALSE(interval.Contains(Angle(-pi + 0.4f)));
+        CHECK_FALSE(interval.Contains(Angle(pi - 0.3f)));
+
+        CHECK(interval.Distance(Angle(pi)) == 0.f);
+        CHECK(interval.Distance(Angle(-pi + 0.5f)) == Approx(0.2f));
+        CHECK(interval.Distance(Angle(pi - 0.5f)) == Approx(0.3f));
+        CHECK(interval.Distance(Angle(0.f)) == Approx(pi - 0.3f));
+
+        CHECK(interval.Overlaps(AngleInterval(Angle(-pi + 0.2f), 1.f)));
+        CHECK(interval.Overlaps(AngleInterval(Angle(2.f), 1.f)));
+        CHECK(interval.Overlaps(AngleInterval(Angle(pi - 0.1f), 0.1f)));
+        CHECK_FALSE(interval.Overlaps(AngleInterval(Angle(-pi + 0.4f), 1.f)));
+        CHECK_FALSE(interval.Overlaps(AngleInterval(Angle(0.f), 1.f)));
+    }
+}
+
+TEST_CASE("Primitives") {
+    SECTION("Sphere") {
+        const Sphere<3> sphere{ { 1.f, 2.f, 3.f }, 2.f };
+        CHECK(sphere.Contains({ 1.f, 2.f, 5.f }));
+        CHECK_FALSE(sphere.Contains({ 1.f, 2.f, 5.1f }));
+        CHECK(sphere.ClosestPoint({ 1.f, 2.f, 4.f }) == Vector<3>{ 1.f, 2.f, 4.f });
+        CHECK(sphere.ClosestPoint({ 1.f, 12.f, 3.f }) == Vector<3>{ 1.f, 4.f, 3.f });
+
+        CHECK(Overlaps(sphere, Sphere<3>{ { 1.f, 2.f, 6.9f }, 2.f }));
+        CHECK_FALSE(Overlaps(sphere, Sphere<3>{ { 1.f, 2.f, 7.f }, 2.f }));
+        CHECK(Overlaps(Sphere<2>{ { 0.f, 0.f }, 1.f }, Sphere<2>{ { 1.f, 1.f }, 0.5f }));
+    }
+
+    SECTION("AABB") {
+        const AABB<3> box{ { -1.f, -2.f, -3.f }, { 1.f, 2.f, 3.f } };
+        CHECK(box.Center() == Vector<3>());
+        CHECK(box.Extents() == Vector<3>{ 1.f, 2.f, 3.f });
+        CHECK(box.Contains(Vector<3>{ 1.f, 0.f, -3.f }));
+        CHECK_FALSE(box.Contains(Vector<3>{ 1.1f, 0.f, 0.f }));
+        CHECK(box.ClosestPoint({ 5.f, 1.f, -7.f }) == Vector<3>{ 1.f, 1.f, -3.f });
+        CHECK(box.Expanded(1.f).Contains(AABB<3>::Around(Sphere<3>{ { 1.f, 2.f, 3.f }, 1.f })));
+
+        const auto merged = AABB<3>::Merged(box, { { 0.f, 0.f, 0.f }, { 4.f, 1.f, 1.f } });
+        CHECK(merged.min == box.min);
+        CHECK(merged.max == Vector<3>{ 4.f, 2.f, 3.f });
+
+        CHECK(Overlaps(box, AABB<3>{ { 0.5f, 1.f, 2.f }, { 3.f, 3.f, 3.f } }));
+        CHECK_FALSE(Overlaps(box, AABB<3>{ { 1.f, 1.f, 2.f }, { 3.f, 3.f, 3.f } }));
+        CHECK(Overlaps(Sphere<3>{ { 2.f, 0.f, 0.f }, 1.1f }, box));
+        CHECK_FALSE(Overlaps(Sphere<3>{ { 2.f, 3.f, 0.f }, 1.1f }, box));
+    }
+
+    SECTION("Ray casts") {
+        const Ray<3> ray{ { -5.f, 0.f, 0.f }, { 2.f, 0.f, 0.f } };
+        CHECK(ray.At(1.5f) == Vector<3>{ -2.f, 0.f, 0.f });
+        CHECK(*RayCast(ray, Sphere<3>{ { 0.f, 0.f, 0.f }, 1.f }) == Approx(2.f));
+        CHECK(*RayCast(ray, Sphere<3>{ { -5.f, 0.5f, 0.f }, 1.f }) == 0.f);
+        CHECK_FALSE(RayCast(ray, Sphere<3>{ { 0.f, 1.5f, 0.f }, 1.f }));
+        CHECK_FALSE(RayCast(ray, Sphere<3>{ { -8.f, 0.f, 0.f }, 1.f }));
+
+        const AABB<3> box{ { -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f } };
+        CHECK(*RayCast(ray, box) == Approx(2.f));
+        CHECK(*RayCast(Ray<3>{ { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f } }, box) == 0.f);
+        CHECK(*RayCast(Ray<3>{ { -3.f, -3.f, 0.f }, { 1.f, 1.f, 0.f } }, box) == Approx(2.f));
+        CHECK_FALSE(RayCast(Ray<3>{ { -5.f, 1.5f, 0.f }, { 1.f, 0.f, 0.f } }, box));
+        CHECK_FALSE(RayCast(Ray<3>{ { 5.f, 0.f, 0.f }, { 1.f, 0.f, 0.f } }, box));
+    }
+
+    SECTION("Annular sector") {
+        // Straddles the -pi / pi seam
+        const AnnularSector sector(10.f, 13.f, AngleInterval(Angle(pi - 0.3f), 0.6f));
+        const auto polar = [](float radius, float angle) { return Vector<2>{ radius * std::cos(angle), radius * std::sin(angle) }; };
+
+        CHECK(sector.Contains(polar(11.f, pi)));
+        CHECK(sector.Contains(polar(12.f, -pi + 0.2f)));
+        CHECK_FALSE(sector.Contains(polar(9.f, pi)));
+        CHECK_FALSE(sector.Contains(polar(11.f, pi - 0.4f)));
+        CHECK_FALSE(sector.Contains(polar(11.f, 0.f)));
+        CHECK(AnnularSector(1.f, 2.f, AngleInterval(Angle(0.f), 5.f)).Contains(polar(1.5f, -1.5f)));
+        CHECK_FALSE(AnnularSector(1.f, 2.f, AngleInterval(Angle(0.f), 5.f)).Contains(polar(1.5f, -0.5f)));
+
+        const auto bounds = sector.Bounds();
+        CHECK(bounds.min[0] == Approx(-13.f));
+        CHECK(bounds.max[0] == Approx(-10.f * std::cos(0.3f)));
+        CHECK(bounds.max[1] == Approx(13.f * std::sin(0.3f)));
+
+        // Closest points against a dense sampling of the sector
+        std::vector<Vector<2>> samples;
+        for (unsigned i = 0; i <= 100; ++i)
+            for (unsigned j = 0; j <= 30; ++j)
+                samples.push_back(polar(10.f + 0.1f * j, pi - 0.3f + 0.006f * i));
+        for (unsigned i = 0; i < 200; ++i) {
+            const Vector<2> point{ RandomFloat() / 4.f, RandomFloat() / 4.f };
+            auto nearest = std::numeric_limits<float>::max();
+            for (const auto& sample : samples)
+                nearest = std::min(nearest, Vector<2>::Distance(point, sample));
+            const auto closest = sector.ClosestPoint(point);
+            REQUIRE(Vector<2>::Distance(sector.ClosestPoint(closest), closest) < 1e-4f);
+            REQUIRE(Vector<2>::Distance(point, closest) <= nearest + 1e-3f);
+            REQUIRE(Vector<2>::Distance(point, closest) >= nearest - 0.11f);
+        }
+
+        CHECK(Overlaps(Sphere<2>{ polar(13.5f, pi), 1.f }, sector));
+        CHECK_FALSE(Overlaps(Sphere<2>{ polar(14.5f, pi), 1.f }, sector));
+        CHECK(Overlaps(Sphere<2>{ polar(11.f, pi - 0.35f), 1.f }, sector));
+        CHECK_FALSE(Overlaps(Sphere<2>{ polar(11.f, 0.f), 1.f }, sector));
+
+        CHECK(*RayCast(Ray<2>{ { -20.f, 0.f }, { 1.f, 0.f } }, sector) == Approx(7.f));
+        CHECK(*RayCast(Ray<2>{ { 0.f, 0.f }, { -2.f, 0.f } }, sector) == Approx(5.f));
+        CHECK(*RayCast(Ray<2>{ polar(11.f, pi), { 0.f, 1.f } }, sector) == 0.f);
+        CHECK_FALSE(RayCast(Ray<2>{ { -20.f, 0.f }, { -1.f, 0.f } }, sector));
+        CHECK_FALSE(RayCast(Ray<2>{ { 20.f, 0.f }, { 1.f, 0.f } }, sector));
+
+        // Ray casts against marching along the ray
+        for (unsigned i = 0; i < 200; ++i) {
+            const Ray<2> ray{ { RandomFloat() / 5.f, RandomFloat() / 5.f }, { RandomFloat(), RandomFloat() } };
+            const auto length = ray.direction.Magnitude();
+            std::optional<float> marched;
+            for (auto t = 0.f; t < 60.f / length; t += 0.005f / length) {
+                if (sector.Contains(ray.At(t))) {
+                    marched = t;
+                    break;
+                }
+            }
+            const auto hit = RayCast(ray, sector);
+            REQUIRE(hit.has_value() == marched.has_value());
+            if (hit)
+                REQUIRE(*hit * length == Approx(*marched * length).margin(0.01f));
+        }
+    }
+
+    SECTION("Sweeps") {
+        const AnnularSector sector(10.f, 13.f, AngleInterval(Angle(pi - 0.3f), 0.6f));
+        const auto polar = [](float radius, float angle) { return Vector<2>{ radius * std::cos(angle), radius * std::sin(angle) }; };
+
+        // Straight through the middle in one step, the outer arc is touched first
+        const auto through = Sweep(Sphere<2>{ { -16.f, 0.f }, 1.f }, { 10.f, 0.f }, sector);
+        REQUIRE(through);
+        CHECK(through->t == Approx(0.2f));
+        CHECK(through->normal[0] == Approx(-1.f));
+        // From the hole outwards onto the inner arc, and onto a corner along the wall line
+        CHECK(Sweep(Sphere<2>{ { 0.f, 0.f }, 1.f }, { -12.f, 0.f }, sector)->t == Approx(0.75f));
+        const auto corner = polar(13.f, pi - 0.3f);
+        const auto cornerHit = Sweep(Sphere<2>{ corner + Vector<2>{ 0.f, 3.f }, 1.f }, { 0.f, -4.f }, sector);
+        REQUIRE(cornerHit);
+        CHECK(cornerHit->t == Approx(0.5f));
+        CHECK(cornerHit->normal[1] == Approx(1.f));
+        // Too short, moving away, not moving and already touching report nothing
+        CHECK_FALSE(Sweep(Sphere<2>{ { -16.f, 0.f }, 1.f }, { 1.f, 0.f }, sector));
+        CHECK_FALSE(Sweep(Sphere<2>{ { -16.f, 0.f }, 1.f }, { -10.f, 0.f }, sector));
+        CHECK_FALSE(Sweep(Sphere<2>{ { -16.f, 0.f }, 1.f }, { 0.f, 0.f }, sector));
+        CHECK_FALSE(Sweep(Sphere<2>{ { -13.5f, 0.f }, 1.f }, { 5.f, 0.f }, sector));
+
+        // Two spheres meet where their centers are both radii apart
+        const auto spheres = Sweep(Sphere<2>{ { -5.f, 0.f }, 1.f }, { 5.f, 0.f }, Sphere<2>{ { 5.f, 0.f }, 1.f }, { -5.f, 0.f });
+        REQUIRE(spheres);
+        CHECK(spheres->t == Approx(0.8f));
+        CHECK(spheres->normal == Vector<2>{ -1.f, 0.f });
+        CHECK(Sweep(Sphere<3>{ { 0.f, 0.f, 0.f }, 1.f }, { 4.f, 0.f, 0.f }, Sphere<3>{ { 4.f, 3.f, 0.f }, 1.f }, { 0.f, -2.f, 0.f })->t == Approx(0.7f));
+        CHECK_FALSE(Sweep(Sphere<2>{ { -5.f, 0.f }, 1.f }, { 5.f, 0.f }, Sphere<2>{ { 5.f, 2.f }, 1.f }, { -5.f, 0.f }));
+        CHECK_FALSE(Sweep(Sphere<2>{ { -5.f, 0.f }, 1.f }, { 1.f, 0.f }, Sphere<2>{ { 5.f, 0.f }, 1.f }, { -1.f, 0.f }));
+        CHECK_FALSE(Sweep(Sphere<2>{ { 0.f, 0.f }, 1.f }, { 1.f, 0.f }, Sphere<2>{ { 1.f, 0.f }, 1.f }, { 0.f, 0.f }));
+
+        // Sweeps against marching along the motion, the normal points from the touched point to the center
+        for (unsigned i = 0; i < 300; ++i) {
+            const Sphere<2> sphere{ { RandomFloat() / 5.f, RandomFloat() / 5.f }, 0.5f + std::abs(RandomFloat()) / 50.f };
+            const Vector<2> motion{ RandomFloat() / 3.f, RandomFloat() / 3.f };
+            if (Overlaps(sphere, sector))
+                continue;
+            std::optional<float> marched;
+            for (auto t = 0.f; t <= 1.f; t += 0.0005f) {
+                if (Overlaps(Sphere<2>{ sphere.center + motion * t, sphere.radius }, sector)) {
+                    marched = t;
+                    break;
+                }
+            }
+            const auto hit = Sweep(sphere, motion, sector);
+            REQUIRE(hit.has_value() == marched.has_value());
+            if (!hit)
+                continue;
+            REQUIRE(hit->t == Approx(*marched).margin(0.001f));
+            REQUIRE(hit->normal.Magnitude() == Approx(1.f).margin(1e-3f));
+            const auto touched = sphere.center + motion * hit->t - hit->normal * sphere.radius;
+            REQUIRE(Vector<2>::Distance(sector.ClosestPoint(touched), touched) < 1e-3f);
+        }
+    }
+}
+
+TEST_CASE("Aligned storage") {
+    // Debug builds also assert in every aligned Simd::Load and Simd::Store, so misaligned storage anywhere in
+    // these tests aborts them instead of going unnoticed on targets that tolerate it
+    SECTION("Alignment check") {
+        alignas(16) float buffer[8] = {};
+        CHECK(Simd::IsAligned(buffer));
+        CHECK_FALSE(Simd::IsAligned(buffer + 1));
+        CHECK_FALSE(Simd::IsAligned(buffer + 2));
+        CHECK(Simd::IsAligned(buffer + 4));
+        CHECK(Simd::IsAligned(buffer + 2, 8));
+    }
+
+    SECTION("Span kernels on unaligned storage") {
+        // One float past a SIMD boundary, every input and output misaligned
+        alignas(16) float x[17];
+        alignas(16) float y[17];
+        alignas(16) float sines[17];
+        alignas(16) float cosines[17];
+        alignas(16) float angles[17];
+        alignas(16) float roots[17];
+        for (size_t i = 0; i < 17; ++i) {
+            x[i] = RandomFloat();
+            y[i] = std::abs(RandomFloat());
+        }
+        SinCos(x + 1, 16, sines + 1, cosines + 1);
+        Atan2(y + 1, x + 1, 16, angles + 1);
+        Sqrt(y + 1, 16, roots + 1);
+        for (size_t i = 1; i < 17; ++i) {
+            const auto sineCosine = SinCos(x[i]);
+            REQUIRE(sines[i] == sineCosine.sine);
+            REQUIRE(cosines[i] == sineCosine.cosine);
+            REQUIRE(angles[i] == Atan2(y[i], x[i]));
+            REQUIRE(roots[i] == std::sqrt(y[i]));
+        }
+    }
+
+    SECTION("Aligned vector") {
+        aligned_vector<float> floats;
+        aligned_vector<Vector<3>> vectors;
+        aligned_vector<Matrix<4>> matrices;
+        for (unsigned i = 0; i < 100; ++i) {
+            floats.push_back(float(i));
+            vectors.emplace_back(float(i));
+            matrices.emplace_back(float(i));
+            // Every reallocation has to land on a SIMD boundary again
+            REQUIRE(Simd::IsAligned(floats.data()));
+            REQUIRE(Simd::IsAligned(vectors.data()));
+            REQUIRE(Simd::IsAligned(matrices.data()));
+        }
+        for (const auto& matrix : matrices)
+            for (size_t row = 0; row < 4; ++row)
+                REQUIRE(Simd::IsAligned(matrix.RowData(row)));
+
+        std::vector<float, AlignedAllocator<float, 64>> cacheLines(10);
+        CHECK(Simd::IsAligned(cacheLines.data(), 64));
+
+        using Rebound = std::allocator_traits<AlignedAllocator<float>>::rebind_alloc<double>;
+        CHECK(Rebound::alignment == Simd::alignment);
+        CHECK(AlignedAllocator<float>() == Rebound());
+    }
+
+    SECTION("VectorArray lanes") {
+        VectorArray<3> array;
+        for (unsigned i = 0; i < 37; ++i) {
+            array.PushBack({ float(i), 0.f, 0.f });
+            for (size_t axis = 0; axis < 3; ++axis)
+                REQUIRE(Simd::IsAligned(array.Lane(axis)));
+        }
+        array.Resize(1000);
+        for (size_t axis = 0; axis < 3; ++axis)
+            CHECK(Simd::IsAligned(array.Lane(axis)));
+    }
+}
+
 TEST_CASE("Utility") {
     SECTION("Radians") {
         CHECK(Radians(10.f) == Approx(glm::radians(10.f)).epsilon(0.0001f));
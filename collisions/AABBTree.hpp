@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "BallCollider.hpp"
+#include "BoundsCollider.hpp"
+#include "BrickCollider.hpp"
+#include "Collider.hpp"
+#include "ColliderVisitor.hpp"
+#include "PlanarBallCollider.hpp"
+
+namespace Collisions {
+
+// Box around a collider on the ground plane, the bounds collider is the disk it keeps the balls in
+inline Geometry::AABB<2> Bounds(const Collider& collider) {
+    struct Visitor : ConstColliderVisitor {
+        Geometry::AABB<2> box;
+
+        void operator()(const BallCollider& ball) override { box = Geometry::AABB<2>::Around({ ball.Position().To2(), ball.Radius }); }
+        void operator()(const PlanarBallCollider& ball) override { box = Geometry::AABB<2>::Around({ ball.Position(), ball.Radius }); }
+        void operator()(const BoundsCollider& bounds) override { box = Geometry::AABB<2>::Around({ Geometry::Vector<2>(), bounds.radius }); }
+        void operator()(const BrickCollider& brick) override { box = brick.Sector().Bounds(); }
+    } visitor;
+    collider.Visit(visitor);
+    return visitor.box;
+}
+
+// Broad phase for any mix of colliders, a bounding volume hierarchy over their Bounds. Leaves keep boxes
+// fattened by a margin, so a collider that moved a little needs no work at all in Update. The rest are
+// reinserted where they grow the tree the least, and rotations on the way back up keep it balanced.
+// Colliders are referenced, not owned. Remove them before destroying them.
+class AABBTree {
+public:
+    using Proxy = uint32_t;
+    constexpr static Proxy null = std::numeric_limits<Proxy>::max();
+
+    struct RayHit {
+        Collider* collider;
+        float t;
+    };
+
+private:
+    // Traversal stack size, a balanced tree of four billion leaves is less than 50 levels deep
+    constexpr static size_t maxDepth = 128;
+
+    struct Node {
+        Geometry::AABB<2> box;
+        Collider* collider = nullptr;
+        // Next free node while the node is on the free list
+        Proxy parent = null;
+        Proxy left = null;
+        Proxy right = null;
+        // Leaves are at height 0, free nodes at -1
+        int height = -1;
+
+        bool IsLeaf() const { return left == null; }
+    };
+
+    float margin;
+    std::vector<Node> nodes;
+    Proxy root = null;
+    Proxy freeList = null;
+    size_t proxyCount = 0;
+
+    // Perimeter of the box, what a subtree costs queries that have to enter it
+    static float Cost(const Geometry::AABB<2>& box) {
+        const auto size = box.max - box.min;
+        return 2.f * (size[0] + size[1]);
+    }
+
+    Proxy AllocateNode() {
+        if (freeList == null) {
+            nodes.emplace_back();
+            freeList = static_cast<Proxy>(nodes.size() - 1);
+        }
+        const auto node = freeList;
+        freeList = nodes[node].parent;
+        nodes[node] = Node();
+        nodes[node].height = 0;
+        return node;
+    }
+
+    void FreeNode(Proxy node) {
+        nodes[node].parent = freeList;
+        nodes[node].height = -1;
+        nodes[node].collider = nullptr;
+        freeList = node;
+    }
+
+    void ReplaceChild(Proxy parent, Proxy oldChild, Proxy newChild) {
+        if (parent == null)
+            root = newChild;
+        else if (nodes[parent].left == oldChild)
+            nodes[parent].left = newChild;
+        else
+            nodes[parent].right = newChild;
+    }
+
+    void Refit(Proxy node) {
+        auto& parent = nodes[node];
+        parent.height = 1 + std::max(nodes[parent.left].height, nodes[parent.right].height);
+        parent.box = Geometry::AABB<2>::Merged(nodes[parent.left].box, nodes[parent.right].box);
+    }
+
+    // Rebalances and refits every ancestor of node
+    void FixUpwards(Proxy node) {
+        while (node != null) {
+            node = Balance(node);
+            Refit(node);
+            node = nodes[node].parent;
+        }
+    }
+
+    void InsertLeaf(Proxy leaf) {
+        if (root == null) {
+            root = leaf;
+            nodes[leaf].parent = null;
+            return;
+        }
+
+        // Walk down to the sibling that adds the least perimeter, counting what every ancestor grows by
+        const auto box = nodes[leaf].box;
+        auto sibling = root;
+        while (!nodes[sibling].IsLeaf()) {
+            const auto& node = nodes[sibling];
+            const auto combined = Cost(Geometry::AABB<2>::Merged(node.box, box));
+            const auto here = 2.f * combined;
+            const auto inherited = 2.f * (combined - Cost(node.box));
+            const auto descend = [&](Proxy child) {
+                const auto merged = Cost(Geometry::AABB<2>::Merged(nodes[child].box, box));
+                return (nodes[child].IsLeaf() ? merged : merged - Cost(nodes[child].box)) + inherited;
+            };
+            const auto left = descend(node.left);
+            const auto right = descend(node.right);
+            if (here < left && here < right)
+                break;
+            sibling = left < right ? node.left : node.right;
+        }
+
+        const auto oldParent = nodes[sibling].parent;
+        const auto newParent = AllocateNode();
+        auto& parent = nodes[newParent];
+        parent.parent = oldParent;
+        parent.left = sibling;
+        parent.right = leaf;
+        ReplaceChild(oldParent, sibling, newParent);
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+        FixUpwards(newParent);
+    }
+
+    void RemoveLeaf(Proxy leaf) {
+        if (leaf == root) {
+            root = null;
+            return;
+        }
+
+        const auto parent = nodes[leaf].parent;
+        const auto grandParent = nodes[parent].parent;
+        const auto sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+        ReplaceChild(grandParent, parent, sibling);
+        nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        FixUpwards(grandParent);
+    }
+
+    // Rotates the taller child of node up when the heights of its children differ by more than one,
+    // returns the node now at the position of node
+    Proxy Balance(Proxy node) {
+        auto& a = nodes[node];
+        if (a.IsLeaf() || a.height < 2)
+            return node;
+
+        const auto balance = nodes[a.right].height - nodes[a.left].height;
+        if (balance >= -1 && balance <= 1)
+            return node;
+
+        // The taller child takes the place of node, node keeps the shorter grandchild
+        const auto tallRight = balance > 1;
+        const auto up = tallRight ? a.right : a.left;
+        auto& b = nodes[up];
+        const auto first = b.left;
+        const auto second = b.right;
+        const auto keepFirst = nodes[first].height > nodes[second].height;
+        const auto kept = keepFirst ? first : second;
+        const auto moved = keepFirst ? second : first;
+
+        b.left = node;
+        b.right = kept;
+        b.parent = a.parent;
+        ReplaceChild(a.parent, node, up);
+        a.parent = up;
+        (tallRight ? a.right : a.left) = moved;
+        nodes[moved].parent = node;
+
+        Refit(node);
+        Refit(up);
+        return up;
+    }
+
+    template <typename Callback>
+    void QueryProxies(const Geometry::AABB<2>& box, Callback callback) const {
+        if (root == null)
+            return;
+        std::array<Proxy, maxDepth> stack;
+        size_t size = 0;
+        stack[size++] = root;
+        while (size > 0) {
+            const auto& node = nodes[stack[--size]];
+            if (!Geometry::Overlaps(node.box, box))
+                continue;
+            if (node.IsLeaf()) {
+                callback(static_cast<Proxy>(&node - nodes.data()));
+                continue;
+            }
+            assert(size + 2 <= maxDepth);
+            stack[size++] = node.left;
+            stack[size++] = node.right;
+        }
+    }
+
+public:
+    // margin is added to every side of the boxes kept for the colliders
+    explicit AABBTree(float margin = 0.1f)
+        : margin(margin) {}
+
+    size_t Size() const { return proxyCount; }
+    // Longest path from the root to a leaf, -1 when empty
+    int Height() const { return root == null ? -1 : nodes[root].height; }
+    const Geometry::AABB<2>& FatBox(Proxy proxy) const { return nodes[proxy].box; }
+    Collider& ColliderOf(Proxy proxy) const { return *nodes[proxy].collider; }
+
+    Proxy Insert(Collider& collider) {
+        return Insert(collider, Bounds(collider));
+    }
+
+    // Keeps box for the collider in place of its Bounds, such as the box around the path a ball moves along
+    Proxy Insert(Collider& collider, const Geometry::AABB<2>& box) {
+        const auto leaf = AllocateNode();
+        nodes[leaf].collider = &collider;
+        nodes[leaf].box = box.Expanded(margin);
+        InsertLeaf(leaf);
+        ++proxyCount;
+        return leaf;
+    }
+
+    // Removes every collider, keeping the memory for the next ones
+    void Clear() {
+        nodes.clear();
+        root = null;
+        freeList = null;
+        proxyCount = 0;
+    }
+
+    void Remove(Proxy proxy) {
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --proxyCount;
+    }
+
+    // Reads the bounds of the collider again, returns whether it left its fat box and was reinserted
+    bool Update(Proxy proxy) {
+        return Update(proxy, Bounds(*nodes[proxy].collider));
+    }
+
+    bool Update(Proxy proxy, const Geometry::AABB<2>& box) {
+        if (nodes[proxy].box.Contains(box))
+            return false;
+
+        RemoveLeaf(proxy);
+        nodes[proxy].box = box.Expanded(margin);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    // Calls callback(collider) for every collider whose fat box overlaps box
+    template <typename Callback>
+    void Query(const Geometry::AABB<2>& box, Callback callback) const {
+        QueryProxies(box, [&](Proxy proxy) { callback(*nodes[proxy].collider); });
+    }
+
+    // Calls callback(first, second) once for every pair of colliders whose fat boxes overlap. The tree is
+    // walked against itself, so subtrees far apart are rejected together and no pair is found twice.
+    template <typename Callback>
+    void ForEachPair(Callback callback) const {
+        if (root == null)
+            return;
+        // Equal nodes stand for all pairs within that subtree
+        std::vector<std::pair<Proxy, Proxy>> stack{ { root, root } };
+        while (!stack.empty()) {
+            const auto [first, second] = stack.back();
+            stack.pop_back();
+            const auto& a = nodes[first];
+            if (first == second) {
+                if (a.IsLeaf())
+                    continue;
+                stack.emplace_back(a.left, a.left);
+                stack.emplace_back(a.right, a.right);
+                stack.emplace_back(a.left, a.right);
+                continue;
+            }
+            const auto& b = nodes[second];
+            if (!Geometry::Overlaps(a.box, b.box))
+                continue;
+            if (a.IsLeaf() && b.IsLeaf()) {
+                callback(*a.collider, *b.collider);
+                continue;
+            }
+            // Split the larger box, or the one that can be split
+            if (b.IsLeaf() || (!a.IsLeaf() && Cost(a.box) > Cost(b.box))) {
+                stack.emplace_back(a.left, second);
+                stack.emplace_back(a.right, second);
+            } else {
+                stack.emplace_back(first, b.left);
+                stack.emplace_back(first, b.right);
+            }
+        }
+    }
+
+    // Closest collider hit by the ray up to maxT. narrow(collider) returns where the ray hits the collider
+    // itself, if anywhere, and is only called for colliders whose fat box is closer than the best hit.
+    template <typename NarrowPhase>
+    std::optional<RayHit> RayCast(const Geometry::Ray<2>& ray, float maxT, NarrowPhase narrow) const {
+        std::optional<RayHit> ret;
+        if (root == null)
+            return ret;
+        std::array<Proxy, maxDepth> stack;
+        size_t size = 0;
+        stack[size++] = root;
+        while (size > 0) {
+            const auto& node = nodes[stack[--size]];
+            const auto entry = Geometry::RayCast(ray, node.box);
+            if (!entry || *entry > maxT)
+                continue;
+            if (node.IsLeaf()) {
+                const auto t = narrow(*node.collider);
+                if (t && *t <= maxT) {
+                    maxT = *t;
+                    ret = RayHit{ node.collider, *t };
+                }
+                continue;
+            }
+            assert(size + 2 <= maxDepth);
+            stack[size++] = node.left;
+            stack[size++] = node.right;
+        }
+        return ret;
+    }
+};
+
+} // namespace Collisions
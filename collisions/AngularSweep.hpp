@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BrickCollider.hpp"
+
+namespace Collisions {
+
+// Sweep and prune over polar angles for ball-collider pairs. Every ball and collider is an arc of polar
+// angles plus a range of radii, arc endpoints are kept sorted over [-pi, pi). Bricks stand still and pads
+// turn a little every step, so the insertion sort in Update only moves a few endpoints by a few places.
+// Colliders are referenced, not owned. Remove them before destroying them.
+class AngularSweep {
+    struct Proxy {
+        // Arc from begin counterclockwise to end, wrapping arcs have end < begin and contain -pi
+        float begin = 0.f;
+        float end = 0.f;
+        float inner = 0.f;
+        float outer = 0.f;
+        // Index into the balls for ball proxies, nullptr marks them
+        size_t ball = 0;
+        BrickCollider* collider = nullptr;
+        // Position in the active list during a sweep
+        uint32_t active = 0;
+
+        bool Wraps() const { return end < begin; }
+    };
+
+    struct Endpoint {
+        float value;
+        uint32_t proxy;
+        bool begin;
+
+        // Begins go first at equal angles, so touching arcs count as overlapping
+        bool operator<(const Endpoint& other) const {
+            return value < other.value || (value == other.value && begin && !other.begin);
+        }
+    };
+
+    std::vector<Proxy> proxies;
+    std::vector<uint32_t> freeProxies;
+    std::vector<Endpoint> endpoints;
+    std::unordered_map<const BrickCollider*, uint32_t> colliderProxies;
+    std::vector<uint32_t> ballProxies;
+    // Scratch lists of the arcs containing the sweep position
+    std::vector<uint32_t> activeBalls;
+    std::vector<uint32_t> activeColliders;
+
+    uint32_t NewProxy() {
+        uint32_t proxy;
+        if (freeProxies.empty()) {
+            proxy = static_cast<uint32_t>(proxies.size());
+            proxies.emplace_back();
+        } else {
+            proxy = freeProxies.back();
+            freeProxies.pop_back();
+        }
+        endpoints.push_back({ 0.f, proxy, true });
+        endpoints.push_back({ 0.f, proxy, false });
+        return proxy;
+    }
+
+    void DeleteProxy(uint32_t proxy) {
+        endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(), [&](const Endpoint& endpoint) { return endpoint.proxy == proxy; }), endpoints.end());
+        proxies[proxy] = Proxy();
+        freeProxies.push_back(proxy);
+    }
+
+    static void SetArc(Proxy& proxy, Geometry::Angle from, float width) {
+        // Anything this wide is the whole circle, which is kept unwrapped
+        if (width >= 2.f * Geometry::pi) {
+            proxy.begin = -Geometry::pi;
+            proxy.end = Geometry::pi;
+            return;
+        }
+        proxy.begin = from.Radians();
+        proxy.end = proxy.begin + width;
+        if (proxy.end >= Geometry::pi)
+            proxy.end -= 2.f * Geometry::pi;
+    }
+
+    template <typename Ball>
+    static void SetBall(Proxy& proxy, const Ball& ball) {
+        const auto distance = ball.Position().To2().Magnitude();
+        proxy.inner = distance - ball.Radius;
+        proxy.outer = distance + ball.Radius;
+        // Within asin(radius / distance) of its own angle, a ball over the origin covers every angle
+        if (distance <= ball.Radius) {
+            SetArc(proxy, Geometry::Angle(), 2.f * Geometry::pi);
+            return;
+        }
+        const auto spread = std::asin(ball.Radius / distance);
+        SetArc(proxy, ball.PositionAngle() - Geometry::Angle(spread), 2.f * spread);
+    }
+
+    static void SetCollider(Proxy& proxy) {
+        const auto interval = proxy.collider->Interval();
+        proxy.inner = proxy.collider->InnerRadius();
+        proxy.outer = proxy.collider->OuterRadius();
+        SetArc(proxy, interval.From(), interval.Width());
+    }
+
+    // Two arcs overlap in up to two pieces, a pair is reported at the first one the sweep meets. Starting
+    // arc begins at value while other is active, an earlier piece exists only if starting wraps and other
+    // reaches into its part before -pi.
+    static bool FirstOverlap(const Proxy& starting, const Proxy& other) {
+        return !starting.Wraps() || (!other.Wraps() && other.begin > starting.end);
+    }
+
+    static bool RadiiOverlap(const Proxy& lhs, const Proxy& rhs) {
+        return lhs.inner <= rhs.outer && rhs.inner <= lhs.outer;
+    }
+
+    static void Activate(std::vector<uint32_t>& list, std::vector<Proxy>& proxies, uint32_t proxy) {
+        proxies[proxy].active = static_cast<uint32_t>(list.size());
+        list.push_back(proxy);
+    }
+
+    static void Deactivate(std::vector<uint32_t>& list, std::vector<Proxy>& proxies, uint32_t proxy) {
+        const auto index = proxies[proxy].active;
+        list[index] = list.back();
+        proxies[list[index]].active = index;
+        list.pop_back();
+    }
+
+public:
+    size_t ColliderCount() const { return colliderProxies.size(); }
+
+    void Add(BrickCollider& collider) {
+        const auto proxy = NewProxy();
+        proxies[proxy].collider = &collider;
+        SetCollider(proxies[proxy]);
+        colliderProxies[&collider] = proxy;
+    }
+
+    void Remove(const BrickCollider& collider) {
+        const auto it = colliderProxies.find(&collider);
+        if (it == colliderProxies.end())
+            return;
+        DeleteProxy(it->second);
+        colliderProxies.erase(it);
+    }
+
+    // Reads the arcs of the balls and of every collider again and restores the endpoint order
+    template <typename Ball, typename Allocator>
+    void Update(const std::vector<Ball, Allocator>& balls) {
+        while (ballProxies.size() > balls.size()) {
+            DeleteProxy(ballProxies.back());
+            ballProxies.pop_back();
+        }
+        while (ballProxies.size() < balls.size()) {
+            const auto proxy = NewProxy();
+            proxies[proxy].ball = ballProxies.size();
+            ballProxies.push_back(proxy);
+        }
+
+        for (size_t i = 0; i < balls.size(); ++i)
+            SetBall(proxies[ballProxies[i]], balls[i]);
+        for (const auto& [collider, proxy] : colliderProxies)
+            SetCollider(proxies[proxy]);
+
+        for (auto& endpoint : endpoints) {
+            const auto& proxy = proxies[endpoint.proxy];
+            endpoint.value = endpoint.begin ? proxy.begin : proxy.end;
+        }
+        // Insertion sort, linear when endpoints barely moved since the last update
+        for (size_t i = 1; i < endpoints.size(); ++i) {
+            const auto endpoint = endpoints[i];
+            auto j = i;
+            for (; j > 0 && endpoint < endpoints[j - 1]; --j)
+                endpoints[j] = endpoints[j - 1];
+            endpoints[j] = endpoint;
+        }
+    }
+
+    // Calls callback(ball, collider) once for every ball index and collider whose arcs and radii overlap,
+    // as of the last Update
+    template <typename Callback>
+    void ForEachPair(Callback callback) {
+        activeBalls.clear();
+        activeColliders.clear();
+        const auto report = [&](uint32_t ball, uint32_t collider) {
+            if (RadiiOverlap(proxies[ball], proxies[collider]))
+                callback(proxies[ball].ball, *proxies[collider].collider);
+        };
+
+        // Wrapping arcs are active from the start, all of them share -pi. Free proxies are empty arcs.
+        for (uint32_t proxy = 0; proxy < proxies.size(); ++proxy) {
+            if (!proxies[proxy].Wraps())
+                continue;
+            Activate(proxies[proxy].collider ? activeColliders : activeBalls, proxies, proxy);
+        }
+        for (const auto ball : activeBalls)
+            for (const auto collider : activeColliders)
+                report(ball, collider);
+
+        for (const auto& endpoint : endpoints) {
+            const auto proxy = endpoint.proxy;
+            const auto isCollider = proxies[proxy].collider != nullptr;
+            auto& list = isCollider ? activeColliders : activeBalls;
+            if (!endpoint.begin) {
+                Deactivate(list, proxies, proxy);
+                continue;
+            }
+
+            for (const auto other : isCollider ? activeBalls : activeColliders) {
+                if (!FirstOverlap(proxies[proxy], proxies[other]))
+                    continue;
+                isCollider ? report(other, proxy) : report(proxy, other);
+            }
+            Activate(list, proxies, proxy);
+        }
+    }
+};
+
+} // namespace Collisions
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "Collider.hpp"
+#include "BoundsCollider.hpp"
+#include "BrickCollider.hpp"
+#include "objects.inl"
+#include <vector>
+
+namespace Collisions {
+namespace Detail {
+
+// Ball responses shared by BallCollider and PlanarBallCollider. Position and velocity are either world
+// space Vector<3> or ground plane Vector<2>, motion itself is planar either way.
+
+template <size_t Size>
+Geometry::Vector<Size> FromPlanar(const Geometry::Vector<2>& vec) {
+    if constexpr (Size == 2)
+        return vec;
+    else
+        return vec.To3();
+}
+
+template <size_t Size>
+Geometry::Vector<Size> FromWorld(const Geometry::Vector<3>& vec) {
+    if constexpr (Size == 2)
+        return vec.To2();
+    else
+        return vec;
+}
+
+template <size_t Size>
+Geometry::Vector<3> ToWorld(const Geometry::Vector<Size>& vec) {
+    return vec.To3();
+}
+
+// Elastic collision of two balls that overlap
+template <size_t Size>
+void BallCollision(Geometry::Vector<Size>& position, Geometry::Vector<Size>& velocity, float mass, Geometry::Vector<Size>& otherPosition, Geometry::Vector<Size>& otherVelocity, float otherMass) {
+    const auto lhs = velocity.To2();
+    const auto rhs = otherVelocity.To2();
+    auto newVelX1 = (lhs[0] * (mass - otherMass) + 2 * otherMass * rhs[0]) / (mass + otherMass);
+    auto newVelZ1 = (lhs[1] * (mass - otherMass) + 2 * otherMass * rhs[1]) / (mass + otherMass);
+    auto newVelX2 = (rhs[0] * (otherMass - mass) + 2 * mass * lhs[0]) / (mass + otherMass);
+    auto newVelZ2 = (rhs[1] * (otherMass - mass) + 2 * mass * lhs[1]) / (mass + otherMass);
+
+    // Move balls to before collision
+    position -= velocity;
+    otherPosition -= otherVelocity;
+
+    // Set new velocity after collision
+    velocity = FromPlanar<Size>({ newVelX1, newVelZ1 });
+    otherVelocity = FromPlanar<Size>({ newVelX2, newVelZ2 });
+}
+
+// Elastic collision of two touching balls, only the velocities along the line between their centers change
+template <size_t Size>
+void BallContact(const Geometry::Vector<Size>& position, Geometry::Vector<Size>& velocity, float mass, const Geometry::Vector<Size>& otherPosition, Geometry::Vector<Size>& otherVelocity, float otherMass) {
+    const auto offset = (position - otherPosition).To2();
+    const auto distance = offset.Magnitude();
+    if (distance == 0.f) {
+        return;
+    }
+
+    // Balls already moving apart keep their velocities
+    const auto normal = offset * (1.f / distance);
+    const auto approach = Geometry::Vector<2>::Dot(velocity.To2() - otherVelocity.To2(), normal);
+    if (approach >= 0.f) {
+        return;
+    }
+    const auto impulse = 2.f * approach / (mass + otherMass);
+    velocity -= FromPlanar<Size>(normal * (impulse * otherMass));
+    otherVelocity += FromPlanar<Size>(normal * (impulse * mass));
+}
+
+// Reflection off the arena bounds the ball crossed
+template <size_t Size>
+void BoundsCollision(Geometry::Vector<Size>& position, Geometry::Vector<Size>& velocity) {
+    const auto velocity2D = velocity.To2().Invert();
+    const auto normal = Geometry::Vector<2>::Inverted(position.To2()).Normalize();
+
+    // Move ball to before collision
+    position -= velocity;
+
+    // Set new velocity
+    velocity = FromPlanar<Size>(2.f * Geometry::Vector<2>::Dot(velocity2D, normal) * normal - velocity2D);
+}
+
+// Collision with a brick or pad on the ground. The ball moved in a straight line from start to position, it
+// is reflected at the time its disk first touched the brick and travels the rest of that path from there,
+// so fast balls can't pass through. A ball that already overlapped the brick at the start, because a pad
+// turned into it, is pushed out of the wall or corner its center points to instead. positionAngle()
+// returns the polar angle of position and is only called in that case. start becomes the point the ball
+// turned at, startTime is the time within the step it was at start and moves to the time of a swept contact.
+template <size_t Size, typename PositionAngle>
+bool BrickCollision(Geometry::Vector<Size>& start, float& startTime, Geometry::Vector<Size>& position, Geometry::Vector<Size>& velocity, float radius, const BrickCollider& other, PositionAngle positionAngle) {
+    const auto sector = other.Sector();
+    const auto end = position.To2();
+    const auto origin = start.To2();
+    const auto motion = end - origin;
+    // The disk around the middle of the motion holds the disk all along it
+    if (!Geometry::Overlaps(Geometry::Sphere<2>{ end - motion * 0.5f, radius + 0.5f * motion.Magnitude() }, sector)) {
+        return false;
+    }
+
+    // Contact point of the center, the normal to reflect off and the part of the step left after the contact
+    Geometry::Vector<2> contact;
+    Geometry::Vector<2> normal;
+    float remaining = 0.f;
+    if (const auto hit = Geometry::Sweep(Geometry::Sphere<2>{ origin, radius }, motion, sector)) {
+        contact = origin + motion * hit->t;
+        normal = hit->normal;
+        remaining = 1.f - hit->t;
+        startTime += hit->t * (1.f - startTime);
+    } else if (Geometry::Overlaps(Geometry::Sphere<2>{ end, radius }, sector)) {
+        // Squared radii and the polar angle pick the wall or corner that was hit
+        const auto magSquared = end.MagnitudeSquared();
+        const auto outerSquared = other.OuterRadius() * other.OuterRadius();
+        const auto innerSquared = other.InnerRadius() * other.InnerRadius();
+        const auto ballAngle = positionAngle();
+        const auto& interval = sector.Angles();
+        // Signed rotations of the ball past either wall, positive outside the brick
+        const auto pastStart = (ballAngle - interval.To()).Radians();
+        const auto pastEnd = (interval.From() - ballAngle).Radians();
+
+        // Every case moves the center straight out to where the disk just touches
+        const auto cornerCollision = [&](const Geometry::Vector<2>& direction) {
+            const auto corner = direction * (magSquared > outerSquared ? other.OuterRadius() : other.InnerRadius());
+            const auto offset = end - corner;
+            const auto dist = offset.Magnitude();
+            const auto ret = dist > 0.f ? offset * (1.f / dist) : Geometry::Vector<2>::Normalized(end);
+            contact = corner + ret * radius;
+            return ret;
+        };
+        const auto wallCollision = [&](const Geometry::Vector<2>& wallNormal) {
+            contact = end + wallNormal * (radius - Geometry::Vector<2>::Dot(end, wallNormal));
+            return wallNormal;
+        };
+        const auto isInRing = magSquared < outerSquared && magSquared > innerSquared;
+        const auto& from = sector.FromDirection();
+        const auto& to = sector.ToDirection();
+
+        if (pastStart > 0.f) {
+            normal = isInRing ? wallCollision({ -to[1], to[0] }) : cornerCollision(to);
+        } else if (pastEnd > 0.f) {
+            normal = isInRing ? wallCollision({ from[1], -from[0] }) : cornerCollision(from);
+        } else if (magSquared > other.MiddleRadius() * other.MiddleRadius()) {
+            normal = Geometry::Vector<2>::Normalized(end);
+            contact = normal * (other.OuterRadius() + radius);
+        } else {
+            normal = Geometry::Vector<2>::Inverted(Geometry::Vector<2>::Normalized(end));
+            contact = normal * (radius - other.InnerRadius());
+        }
+    } else {
+        return false;
+    }
+
+    // Reflect the path and the velocity off the normal and finish the path, they differ once the velocity
+    // was damped or changed since start. The brick carries the ball along as it turns, side walls and
+    // corners push the ball with them.
+    const auto reflect = [&](const Geometry::Vector<2>& vec) { return vec - normal * (2.f * Geometry::Vector<2>::Dot(vec, normal)); };
+    const auto contactSquared = contact.MagnitudeSquared();
+    const auto isInRing = contactSquared < other.OuterRadius() * other.OuterRadius() && contactSquared > other.InnerRadius() * other.InnerRadius();
+    const auto isInCone = sector.ContainsDirection(contact);
+    const float movementMultiplier = isInRing ? 1.1f : 0.2f;
+
+    start += FromPlanar<Size>(contact - origin);
+    position += FromPlanar<Size>(contact + reflect(motion) * remaining - end);
+    const auto carried = FromWorld<Size>(other.Velocity(ToWorld(position))) * movementMultiplier;
+    velocity = FromPlanar<Size>(reflect(velocity.To2()));
+    velocity += carried;
+    if (isInRing || !isInCone) {
+        position += carried;
+    }
+    return true;
+}
+
+// State and behaviour shared by BallCollider and PlanarBallCollider, Derived is the collider itself and
+// provides WorldPosition() for the bounds check
+template <typename Derived, size_t Size>
+class Ball : public Collider {
+protected:
+    Geometry::Vector<Size> position;
+    Geometry::Vector<Size> velocity;
+    // Where the straight path that ends at position began, set by Step and moved by every response that
+    // turns or moves the ball, and the time within the step the ball was there. The ball is at position at
+    // the end of the step.
+    Geometry::Vector<Size> start;
+    float startTime = 0.f;
+    // Polar angle of position, filled for every ball by Step(balls) and recomputed on demand once the
+    // position moved
+    mutable Geometry::Angle positionAngle;
+    mutable bool positionAngleValid = false;
+
+    Ball(Geometry::Vector<Size>&& position, Geometry::Vector<Size>&& velocity, float radius, float maxVelocity)
+        : position(std::move(position)),
+          velocity(std::move(velocity)),
+          start(this->position),
+          Radius(radius),
+          Mass(4 * Geometry::pi * radius * radius * radius * 11.34f / 3),
+          MaxVelocity(maxVelocity) {}
+
+public:
+    const float Radius;
+    const float Mass;
+    const float MaxVelocity;
+
+    void Step() {
+        start = position;
+        startTime = 0.f;
+        position += velocity;
+        positionAngleValid = false;
+
+        if (velocity.MagnitudeSquared() > MaxVelocity * MaxVelocity) {
+            velocity *= 0.9;
+        }
+    }
+
+    // Steps every ball and fills its polar angle for the index lookups and brick responses that follow.
+    // A plain loop: copying the balls into VectorArray lanes and back costs more than the batch kernels save
+    // at game sizes.
+    template <typename Allocator>
+    static void Step(std::vector<Derived, Allocator>& balls) {
+        for (auto& ball : balls) {
+            ball.Step();
+            ball.PositionAngle();
+        }
+    }
+
+    const Geometry::Vector<Size>& Position() const { return position; }
+    const Geometry::Vector<Size>& Velocity() const { return velocity; }
+    const Geometry::Vector<Size>& Start() const { return start; }
+    float StartTime() const { return startTime; }
+
+    Geometry::Angle PositionAngle() const {
+        if (!positionAngleValid) {
+            positionAngle = Geometry::Angle::Polar(position.To2());
+            positionAngleValid = true;
+        }
+        return positionAngle;
+    }
+
+    bool DidCollide(const Derived& other) const {
+        const Ball& rhs = other;
+        const auto radii = Radius + rhs.Radius;
+        return Geometry::Vector<Size>::DistanceSquared(position, rhs.position) < radii * radii;
+    }
+
+    // Measured from the world space center, so planar balls above the ground match world space ones
+    bool DidCollide(const BoundsCollider& other) const {
+        // Squaring only keeps the answer for a non-negative limit, a ball bigger than the bounds always collides
+        const auto limit = other.radius - Radius;
+        return limit < 0.f || static_cast<const Derived&>(*this).WorldPosition().MagnitudeSquared() > limit * limit;
+    }
+
+    // Moves the ball by fraction of its velocity, negative fractions move it back
+    void Advance(float fraction) {
+        position += velocity * fraction;
+        positionAngleValid = false;
+    }
+
+    // Moves the ball back to where its path from Start() is at time within the step, no earlier than
+    // StartTime()
+    void Rewind(float time) {
+        if (startTime < 1.f) {
+            position = start + (position - start) * ((time - startTime) / (1.f - startTime));
+        }
+        positionAngleValid = false;
+    }
+
+    // Elastic collision with a ball touching this one at time within the step, along the line between
+    // their centers
+    void Contact(Derived& other, float time) {
+        Ball& rhs = other;
+        BallContact(position, velocity, Mass, rhs.position, rhs.velocity, rhs.Mass);
+        start = position;
+        rhs.start = rhs.position;
+        startTime = time;
+        rhs.startTime = time;
+    }
+
+    void Collision(Derived& other) {
+        Ball& rhs = other;
+        if (&rhs == this || !DidCollide(other)) {
+            return;
+        }
+
+        BallCollision(position, velocity, Mass, rhs.position, rhs.velocity, rhs.Mass);
+        // Both balls are sent back to about where they began the step and rest there for the step
+        start = position;
+        rhs.start = rhs.position;
+        startTime = 0.f;
+        rhs.startTime = 0.f;
+        positionAngleValid = false;
+        rhs.positionAngleValid = false;
+    }
+
+    bool Collision(const BrickCollider& other) {
+        if (other.Height() != 0) {
+            return false;
+        }
+
+        if (!BrickCollision(start, startTime, position, velocity, Radius, other, [this] { return PositionAngle(); })) {
+            return false;
+        }
+        positionAngleValid = false;
+        return true;
+    }
+
+    void Collision(const BoundsCollider& other) {
+        if (!DidCollide(other)) {
+            return;
+        }
+
+        BoundsCollision(position, velocity);
+        // Sent back to about where the ball began the step, it rests there for the step
+        start = position;
+        startTime = 0.f;
+        positionAngleValid = false;
+    }
+};
+
+} // namespace Detail
+} // namespace Collisions
@@ -8,50 +8,72 @@ namespace Collisions {
 class BrickCollider : public Collider {
     float distance;
     unsigned segmentsCount;
-    float angleStart;
+    Geometry::Angle angleStart;
     float height;
     float angularVelocity = 0.f;
+    // Sine and cosine of the angle from start to end, constant for the brick
+    Geometry::SineCosine span;
+
+    // Cached so corners and velocity don't recompute sin/cos for every ball
+    Geometry::Rotation velocityRotation;
+    Geometry::Rotation startRotation;
+    Geometry::Rotation endRotation;
     
     BrickCollider* firstParent = nullptr;
     BrickCollider* secondParent = nullptr;
 
+    void UpdateRotations() {
+        const auto start = Geometry::SinCos(-AngleStart());
+        startRotation = Geometry::Rotation::AroundY(-AngleStart(), start);
+        endRotation = Geometry::Rotation::AroundY(-AngleEnd(), Geometry::SinCosSum(start, span));
+    }
+
 public:
     BrickCollider(float distance, unsigned segmentsCount, float angle = 0.f, float height = 0.f)
         : distance(distance),
           segmentsCount(segmentsCount),
-          angleStart(angle > Geometry::pi ? angle - 2 * Geometry::pi : angle < -Geometry::pi ? angle + 2 * Geometry::pi : angle),
-          height(height) {}
+          angleStart(angle),
+          height(height),
+          span(Geometry::SinCos(-static_cast<float>(segmentsCount) * ANGLE)) {
+        UpdateRotations();
+    }
 
     // Visitors
     void Visit(ColliderVisitor& visitor) override { visitor(*this); }
     void Visit(ConstColliderVisitor& visitor) const override { visitor(*this); }
 
     void Rotate(float angle) {
+        if (angle != angularVelocity) {
+            velocityRotation = Geometry::Rotation::AroundY(angle, Geometry::SinCos(angle));
+        }
         angularVelocity = angle;
-        angleStart += angle;
-        if (angleStart > Geometry::pi) {
-            angleStart -= 2 * Geometry::pi;
-        } else if (angleStart < -Geometry::pi) {
-            angleStart += 2 * Geometry::pi;
+        if (angle == 0.f) {
+            return;
         }
+
+        angleStart += Geometry::Angle(angle);
+        UpdateRotations();
     }
 
     float InnerRadius() const { return distance; }
     float OuterRadius() const { return distance + BRICK_WIDTH; }
     float MiddleRadius() const { return distance + BRICK_WIDTH / 2.f; }
-    float AngleStart() const { return angleStart; }
-    float AngleEnd() const { return angleStart + static_cast<float>(segmentsCount) * ANGLE; }
+    float AngleStart() const { return angleStart.Radians(); }
+    float AngleEnd() const { return AngleStart() + static_cast<float>(segmentsCount) * ANGLE; }
+    // Polar angles covered by the brick, counterclockwise from the end wall to the start wall
+    Geometry::AngleInterval Interval() const { return { Geometry::Angle(AngleEnd()), -static_cast<float>(segmentsCount) * ANGLE }; }
+    Geometry::AnnularSector Sector() const { return { InnerRadius(), OuterRadius(), Interval() }; }
     float Height() const { return height; }
 
     Geometry::Vector<3> Velocity(const Geometry::Vector<3>& position) const {
-        const auto rotated = Geometry::Vector<3>(position).Rotate(angularVelocity, { 0.f, 1.f, 0.f });
+        const auto rotated = velocityRotation.Apply(position);
         return (rotated - position).Invert();
     }
 
-    Geometry::Vector<3> InnerStartCorner() const { return Geometry::Vector<3>{ InnerRadius(), 1.f, 0.f }.Rotate(-AngleStart(), { 0.f, 1.f, 0.f }); }
-    Geometry::Vector<3> InnerEndCorner() const { return Geometry::Vector<3>{ InnerRadius(), 1.f, 0.f }.Rotate(-AngleEnd(), { 0.f, 1.f, 0.f }); }
-    Geometry::Vector<3> OuterStartCorner() const { return Geometry::Vector<3>{ OuterRadius(), 1.f, 0.f }.Rotate(-AngleStart(), { 0.f, 1.f, 0.f }); }
-    Geometry::Vector<3> OuterEndCorner() const { return Geometry::Vector<3>{ OuterRadius(), 1.f, 0.f }.Rotate(-AngleEnd(), { 0.f, 1.f, 0.f }); }
+    Geometry::Vector<3> InnerStartCorner() const { return startRotation.Apply({ InnerRadius(), 1.f, 0.f }); }
+    Geometry::Vector<3> InnerEndCorner() const { return endRotation.Apply({ InnerRadius(), 1.f, 0.f }); }
+    Geometry::Vector<3> OuterStartCorner() const { return startRotation.Apply({ OuterRadius(), 1.f, 0.f }); }
+    Geometry::Vector<3> OuterEndCorner() const { return endRotation.Apply({ OuterRadius(), 1.f, 0.f }); }
     
     bool ShouldBeDeleted = false;
 
@@ -71,4 +93,7 @@ public:
     }
 };
 
+// Cached rotations hold aligned SIMD vectors, containers of bricks need Geometry::aligned_vector
+static_assert(alignof(BrickCollider) == Geometry::Simd::alignment, "BrickCollider must keep the alignment of Vector<3>.");
+
 } // namespace Collisions
@@ -5,6 +5,7 @@ namespace Collisions {
 class BallCollider;
 class BoundsCollider;
 class BrickCollider;
+class PlanarBallCollider;
 
 class IColliderVisitor {
 public:
@@ -13,6 +14,7 @@ public:
     virtual void operator()(BallCollider&) = 0;
     virtual void operator()(BoundsCollider&) = 0;
     virtual void operator()(BrickCollider&) = 0;
+    virtual void operator()(PlanarBallCollider&) = 0;
 };
 
 class IConstColliderVisitor {
@@ -22,6 +24,7 @@ public:
     virtual void operator()(const BallCollider&) = 0;
     virtual void operator()(const BoundsCollider&) = 0;
     virtual void operator()(const BrickCollider&) = 0;
+    virtual void operator()(const PlanarBallCollider&) = 0;
 };
 
 class ColliderVisitor : IColliderVisitor {
@@ -31,6 +34,7 @@ public:
     virtual void operator()(BallCollider&) override{};
     virtual void operator()(BoundsCollider&) override{};
     virtual void operator()(BrickCollider&) override{};
+    virtual void operator()(PlanarBallCollider&) override{};
 };
 
 class ConstColliderVisitor : IConstColliderVisitor {
@@ -40,6 +44,7 @@ public:
     virtual void operator()(const BallCollider&) override{};
     virtual void operator()(const BoundsCollider&) override{};
     virtual void operator()(const BrickCollider&) override{};
+    virtual void operator()(const PlanarBallCollider&) override{};
 };
 
 } // namespace Collisions
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "AABBTree.hpp"
+#include "Collider.hpp"
+
+namespace Collisions {
+
+// Ball-ball collisions in the order they happen within a step. Every ball moved in a straight line from
+// Start() at StartTime() to Position() at the end of the step. Resolve replays those motions: it predicts when pairs first touch,
+// keeps the predictions in a priority queue and processes the earliest one, predicting again for the two
+// balls it changed. Predictions made before one of their balls collided are stale and skipped. Only balls
+// whose own paths come close are ever tested, however fast the other balls are.
+class ContactQueue {
+    // Bounds the work per step when balls are packed so tight they keep hitting each other
+    constexpr static size_t eventsPerBall = 8;
+
+    struct Event {
+        float t;
+        uint32_t first;
+        uint32_t second;
+        // Contacts both balls had when the event was predicted
+        uint32_t firstContacts;
+        uint32_t secondContacts;
+
+        bool operator>(const Event& other) const { return t > other.t; }
+    };
+
+    // Boxes around the paths of the balls
+    AABBTree tree{ 0.f };
+    std::vector<AABBTree::Proxy> proxies;
+    // Min heap on time
+    std::vector<Event> events;
+    // Time within the step every ball's position is at, the motion over the whole step it continues with
+    // from there and its contacts so far
+    std::vector<float> times;
+    std::vector<Geometry::Vector<2>> motions;
+    std::vector<uint32_t> contacts;
+
+    static Geometry::AABB<2> PathBox(const Geometry::Vector<2>& start, const Geometry::Vector<2>& end, float radius) {
+        return Geometry::AABB<2>::Merged(Geometry::AABB<2>::Around({ start, radius }), Geometry::AABB<2>::Around({ end, radius }));
+    }
+
+    template <typename Ball, typename Allocator>
+    void Predict(const std::vector<Ball, Allocator>& balls, uint32_t first, uint32_t second, float now) {
+        const auto& lhs = balls[first];
+        const auto& rhs = balls[second];
+        const auto& lhsMotion = motions[first];
+        const auto& rhsMotion = motions[second];
+        // Paths are only known from the time both balls were at their start, a ball that turned off a brick
+        // can't meet others before
+        const auto from = std::max({ now, lhs.StartTime(), rhs.StartTime() });
+        const Geometry::Sphere<2> lhsSphere{ lhs.Position().To2() + lhsMotion * (from - times[first]), lhs.Radius };
+        const Geometry::Sphere<2> rhsSphere{ rhs.Position().To2() + rhsMotion * (from - times[second]), rhs.Radius };
+
+        // Balls overlapping already, which only happens when they started the step that way, collide right away
+        // unless they are moving apart
+        auto t = from;
+        if (Geometry::Overlaps(lhsSphere, rhsSphere)) {
+            if (Geometry::Vector<2>::Dot(lhsSphere.center - rhsSphere.center, lhsMotion - rhsMotion) >= 0.f)
+                return;
+        } else {
+            const auto remaining = 1.f - from;
+            const auto hit = Geometry::Sweep(lhsSphere, lhsMotion * remaining, rhsSphere, rhsMotion * remaining);
+            if (!hit)
+                return;
+            t = from + hit->t * remaining;
+        }
+
+        events.push_back({ t, first, second, contacts[first], contacts[second] });
+        std::push_heap(events.begin(), events.end(), std::greater<Event>());
+    }
+
+public:
+    // Collides the balls in time order over their last step and leaves them where the step ends, returns
+    // the number of contacts processed
+    template <typename Ball, typename Allocator>
+    size_t Resolve(std::vector<Ball, Allocator>& balls) {
+        const auto count = balls.size();
+
+        // Pairs can only meet while the boxes around the rest of their paths overlap. The tree keeps those
+        // boxes, every ball's whole path to begin with.
+        tree.Clear();
+        proxies.resize(count);
+        motions.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto start = balls[i].Start().To2();
+            const auto end = balls[i].Position().To2();
+            // Motion over a whole step, a ball that only got to its start at the end of the step rests there
+            const auto startTime = balls[i].StartTime();
+            motions[i] = startTime < 1.f ? (end - start) * (1.f / (1.f - startTime)) : Geometry::Vector<2>();
+            proxies[i] = tree.Insert(balls[i], PathBox(start, end, balls[i].Radius));
+        }
+        const auto index = [&](Collider& collider) { return static_cast<uint32_t>(&static_cast<Ball&>(collider) - balls.data()); };
+
+        // Positions stay at the end of the step until a ball is involved in a contact
+        times.assign(count, 1.f);
+        contacts.assign(count, 0);
+        events.clear();
+        tree.ForEachPair([&](Collider& first, Collider& second) { Predict(balls, index(first), index(second), 0.f); });
+
+        size_t processed = 0;
+        while (!events.empty() && processed < eventsPerBall * count) {
+            std::pop_heap(events.begin(), events.end(), std::greater<Event>());
+            const auto event = events.back();
+            events.pop_back();
+            if (event.firstContacts != contacts[event.first] || event.secondContacts != contacts[event.second])
+                continue;
+
+            // Balls without contacts are still at the end of their recorded path, the others continue on their
+            // velocity from the last contact
+            for (const auto ball : { event.first, event.second }) {
+                if (contacts[ball] == 0)
+                    balls[ball].Rewind(event.t);
+                else
+                    balls[ball].Advance(event.t - times[ball]);
+                times[ball] = event.t;
+                ++contacts[ball];
+            }
+            balls[event.first].Contact(balls[event.second], event.t);
+            ++processed;
+
+            // Both balls take a new path for the rest of the step, which may reach balls the old one didn't
+            for (const auto ball : { event.first, event.second }) {
+                motions[ball] = balls[ball].Velocity().To2();
+                const auto position = balls[ball].Position().To2();
+                const auto box = PathBox(position, position + motions[ball] * (1.f - event.t), balls[ball].Radius);
+                tree.Update(proxies[ball], box);
+                tree.Query(box, [&](Collider& collider) {
+                    const auto other = index(collider);
+                    if (other != ball)
+                        Predict(balls, ball, other, event.t);
+                });
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            if (times[i] != 1.f)
+                balls[i].Advance(1.f - times[i]);
+        return processed;
+    }
+};
+
+} // namespace Collisions
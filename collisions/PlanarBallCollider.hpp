@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Collider.hpp"
+#include "BallCollider.hpp"
+#include "BallResponse.hpp"
+#include "BoundsCollider.hpp"
+#include "BrickCollider.hpp"
+#include "objects.inl"
+
+namespace Collisions {
+
+// BallCollider that keeps its state on the ground plane. Vector<2> holds { x, z } and the ball sits at a
+// fixed Height, which the bounds check and rendering add back. Balls only ever move in the plane, so the
+// simulation matches BallCollider for balls sharing one height while position and velocity take half the
+// memory.
+class PlanarBallCollider : public Detail::Ball<PlanarBallCollider, 2> {
+public:
+    const float Height;
+
+    PlanarBallCollider(Geometry::Vector<2>&& position, Geometry::Vector<2>&& velocity, float radius, float maxVelocity = 1.5f, float height = 1.f)
+        : Ball(std::move(position), std::move(velocity), radius, maxVelocity),
+          Height(height) {}
+
+    // Drops the vertical components, the height the ball is at becomes its Height
+    explicit PlanarBallCollider(const BallCollider& ball)
+        : PlanarBallCollider(ball.Position().To2(), ball.Velocity().To2(), ball.Radius, ball.MaxVelocity, ball.Position().Y()) {}
+
+    // Visitors
+    void Visit(ColliderVisitor& visitor) override { visitor(*this); }
+    void Visit(ConstColliderVisitor& visitor) const override { visitor(*this); }
+
+    // World space counterparts for rendering
+    Geometry::Vector<3> WorldPosition() const { return { position[0], Height, position[1] }; }
+    Geometry::Vector<3> WorldVelocity() const { return velocity.To3(); }
+};
+
+} // namespace Collisions
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BrickCollider.hpp"
+
+namespace Collisions {
+
+// Broad phase for bricks and pads. Every one of them lies on a ring at a fixed radius, so they are
+// bucketed by ring and by the angular sectors their interval covers. A ball only looks at the rings it
+// reaches and, on those, at the sectors its own disk spans.
+// Colliders are referenced, not owned. Call Update after rotating one and Remove before destroying it.
+class PolarIndex {
+    struct Ring {
+        float inner;
+        float outer;
+        // Slots of the colliders covering every sector
+        std::vector<std::vector<uint32_t>> sectors;
+    };
+
+    struct Slot {
+        BrickCollider* collider = nullptr;
+        size_t ring = 0;
+        size_t firstSector = 0;
+        size_t sectorCount = 0;
+        // Last query that reported the collider, a collider in several sectors is reported once
+        unsigned stamp = 0;
+    };
+
+    size_t sectorCount;
+    float sectorWidth;
+    std::vector<Ring> rings;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<const BrickCollider*, uint32_t> slotOf;
+    unsigned queryStamp = 0;
+
+    size_t SectorOf(Geometry::Angle angle) const {
+        return std::min(static_cast<size_t>((angle.Radians() + Geometry::pi) / sectorWidth), sectorCount - 1);
+    }
+
+    bool InRange(size_t sector, size_t first, size_t count) const {
+        return (sector + sectorCount - first) % sectorCount < count;
+    }
+
+    // First sector and number of sectors the counterclockwise arc from from to from + width touches
+    std::pair<size_t, size_t> SectorRange(Geometry::Angle from, float width) const {
+        // An arc this wide could end in the sector it starts in
+        if (width >= 2.f * Geometry::pi - sectorWidth)
+            return { 0, sectorCount };
+        const auto first = SectorOf(from);
+        const auto last = SectorOf(from + Geometry::Angle(width));
+        return { first, (last + sectorCount - first) % sectorCount + 1 };
+    }
+
+    std::pair<size_t, size_t> SectorRange(const BrickCollider& collider) const {
+        const auto interval = collider.Interval();
+        return SectorRange(interval.From(), interval.Width());
+    }
+
+    size_t RingOf(const BrickCollider& collider) {
+        for (size_t i = 0; i < rings.size(); ++i)
+            if (rings[i].inner == collider.InnerRadius() && rings[i].outer == collider.OuterRadius())
+                return i;
+        rings.push_back({ collider.InnerRadius(), collider.OuterRadius(), std::vector<std::vector<uint32_t>>(sectorCount) });
+        return rings.size() - 1;
+    }
+
+    void Unlink(uint32_t slot, size_t sector) {
+        auto& bucket = rings[slots[slot].ring].sectors[sector];
+        const auto it = std::find(bucket.begin(), bucket.end(), slot);
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+
+public:
+    // sectorCount sectors of equal width per ring, about one per brick keeps buckets short
+    explicit PolarIndex(size_t sectorCount)
+        : sectorCount(std::max<size_t>(sectorCount, 1)),
+          sectorWidth(2.f * Geometry::pi / static_cast<float>(this->sectorCount)) {}
+
+    size_t Size() const { return slotOf.size(); }
+    size_t RingCount() const { return rings.size(); }
+
+    void Add(BrickCollider& collider) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        const auto [first, count] = SectorRange(collider);
+        slots[slot] = { &collider, RingOf(collider), first, count, 0 };
+        for (size_t i = 0; i < count; ++i)
+            rings[slots[slot].ring].sectors[(first + i) % sectorCount].push_back(slot);
+        slotOf[&collider] = slot;
+    }
+
+    // Moves the collider to the sectors it covers now, only the sectors it entered or left are touched
+    void Update(const BrickCollider& collider) {
+        const auto slot = slotOf.at(&collider);
+        auto& entry = slots[slot];
+        const auto [first, count] = SectorRange(collider);
+        if (first == entry.firstSector && count == entry.sectorCount)
+            return;
+
+        for (size_t i = 0; i < entry.sectorCount; ++i) {
+            const auto sector = (entry.firstSector + i) % sectorCount;
+            if (!InRange(sector, first, count))
+                Unlink(slot, sector);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const auto sector = (first + i) % sectorCount;
+            if (!InRange(sector, entry.firstSector, entry.sectorCount))
+                rings[entry.ring].sectors[sector].push_back(slot);
+        }
+        entry.firstSector = first;
+        entry.sectorCount = count;
+    }
+
+    void Remove(const BrickCollider& collider) {
+        const auto it = slotOf.find(&collider);
+        if (it == slotOf.end())
+            return;
+
+        const auto slot = it->second;
+        for (size_t i = 0; i < slots[slot].sectorCount; ++i)
+            Unlink(slot, (slots[slot].firstSector + i) % sectorCount);
+        slots[slot].collider = nullptr;
+        freeSlots.push_back(slot);
+        slotOf.erase(it);
+    }
+
+    void Clear() {
+        rings.clear();
+        slots.clear();
+        freeSlots.clear();
+        slotOf.clear();
+    }
+
+    // Calls callback(collider) once for every collider on a ring the disk reaches whose sectors overlap the
+    // sectors the disk spans there. angle is the polar angle of center. The index can't change meanwhile.
+    template <typename Callback>
+    void ForEachNear(const Geometry::Vector<2>& center, Geometry::Angle angle, float radius, Callback callback) {
+        if (++queryStamp == 0) {
+            for (auto& slot : slots)
+                slot.stamp = 0;
+            queryStamp = 1;
+        }
+
+        const auto squared = center.MagnitudeSquared();
+        for (const auto& ring : rings) {
+            // Same rejection as Geometry::Overlaps against the ring's sectors
+            const auto outer = ring.outer + radius;
+            const auto inner = ring.inner - radius;
+            if (squared >= outer * outer || (inner > 0.f && squared <= inner * inner))
+                continue;
+
+            // The disk is at least inner away from the origin, so it spans at most asin(radius / inner) to
+            // either side of its center. Closer in it could cover any angle.
+            auto range = std::pair<size_t, size_t>{ 0, sectorCount };
+            if (inner > radius) {
+                const auto spread = std::asin(radius / inner);
+                range = SectorRange(angle - Geometry::Angle(spread), 2.f * spread);
+            }
+
+            for (size_t i = 0; i < range.second; ++i) {
+                for (const auto slot : ring.sectors[(range.first + i) % sectorCount]) {
+                    if (slots[slot].stamp == queryStamp)
+                        continue;
+                    slots[slot].stamp = queryStamp;
+                    callback(*slots[slot].collider);
+                }
+            }
+        }
+    }
+
+    // Ball colliders query the disk around the path of their last step, from Start() to Position(), so swept
+    // collisions see every collider the ball passed. Resting balls reuse the polar angle of their position.
+    template <typename Ball, typename Callback>
+    void ForEachNear(const Ball& ball, Callback callback) {
+        const auto start = ball.Start().To2();
+        const auto position = ball.Position().To2();
+        if (start == position) {
+            ForEachNear(position, ball.PositionAngle(), ball.Radius, callback);
+            return;
+        }
+        const auto center = (start + position) * 0.5f;
+        ForEachNear(center, Geometry::Angle::Polar(center), ball.Radius + Geometry::Vector<2>::Distance(start, position) * 0.5f, callback);
+    }
+};
+
+} // namespace Collisions
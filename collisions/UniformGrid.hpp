@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Geometry"
+
+namespace Collisions {
+
+// Broad phase for ball-ball collisions on the ground plane. The square around the arena is split into
+// cells at least one ball diameter wide, so two balls can only touch when their cells are the same or
+// adjacent. Build sorts the balls into cells, ForEachPair then reports every such pair exactly once.
+class UniformGrid {
+    // Keeps the cell array bounded however small the balls get
+    constexpr static size_t maxColumns = 1024;
+
+    float radius;
+    float cellSize = 0.f;
+    float inverseCellSize = 0.f;
+    size_t columns = 0;
+    // Ball indices sorted by cell, cell c holds entries[cellStarts[c]] up to entries[cellStarts[c + 1]]
+    std::vector<uint32_t> cellStarts;
+    std::vector<uint32_t> entries;
+    std::vector<uint32_t> ballCells;
+
+    size_t Coordinate(float value) const {
+        // Balls that slipped past the bounds land in the border cells, which only adds candidates
+        return static_cast<size_t>(std::clamp((value + radius) * inverseCellSize, 0.f, static_cast<float>(columns - 1)));
+    }
+
+public:
+    // radius of the disk the balls move in, centered on the origin
+    explicit UniformGrid(float radius)
+        : radius(radius) {}
+
+    float CellSize() const { return cellSize; }
+    size_t Columns() const { return columns; }
+
+    // Sorts the balls into cells sized from the largest of them, run again whenever they moved
+    template <typename Ball, typename Allocator>
+    void Build(const std::vector<Ball, Allocator>& balls) {
+        auto largest = 0.f;
+        for (const auto& ball : balls)
+            largest = std::max(largest, ball.Radius);
+
+        const auto span = 2.f * radius;
+        const auto fitting = largest > 0.f ? std::floor(span / (2.f * largest)) : static_cast<float>(maxColumns);
+        columns = static_cast<size_t>(std::clamp(fitting, 1.f, static_cast<float>(maxColumns)));
+        // Rounding columns down makes the cells at least one diameter wide
+        cellSize = std::max(span / static_cast<float>(columns), 2.f * largest);
+        inverseCellSize = 1.f / cellSize;
+
+        // Counting sort, cellStarts first holds the end of every cell and walks back to its start while
+        // the balls are placed in reverse, which leaves every cell in ascending ball order
+        const auto cellCount = columns * columns;
+        cellStarts.assign(cellCount + 1, 0);
+        ballCells.resize(balls.size());
+        for (size_t i = 0; i < balls.size(); ++i) {
+            const auto position = balls[i].Position().To2();
+            const auto cell = static_cast<uint32_t>(Coordinate(position[1]) * columns + Coordinate(position[0]));
+            ballCells[i] = cell;
+            ++cellStarts[cell];
+        }
+        for (size_t cell = 1; cell <= cellCount; ++cell)
+            cellStarts[cell] += cellStarts[cell - 1];
+        entries.resize(balls.size());
+        for (size_t i = balls.size(); i-- > 0;)
+            entries[--cellStarts[ballCells[i]]] = static_cast<uint32_t>(i);
+    }
+
+    // Calls callback(i, j) with the indices of every pair of balls in the same or adjacent cells. Only
+    // occupied cells are visited, each against itself and the four neighbours after it in memory order.
+    template <typename Callback>
+    void ForEachPair(Callback callback) const {
+        for (size_t first = 0; first < entries.size();) {
+            const auto cell = ballCells[entries[first]];
+            const auto end = cellStarts[cell + 1];
+
+            for (auto i = first; i < end; ++i)
+                for (auto j = i + 1; j < end; ++j)
+                    callback(size_t(entries[i]), size_t(entries[j]));
+
+            const auto visitNeighbour = [&](size_t neighbour) {
+                for (auto i = first; i < end; ++i)
+                    for (auto j = cellStarts[neighbour]; j < cellStarts[neighbour + 1]; ++j)
+                        callback(size_t(entries[i]), size_t(entries[j]));
+            };
+            const auto column = cell % columns;
+            const auto row = cell / columns;
+            if (column + 1 < columns)
+                visitNeighbour(cell + 1);
+            if (row + 1 < columns) {
+                if (column > 0)
+                    visitNeighbour(cell + columns - 1);
+                visitNeighbour(cell + columns);
+                if (column + 1 < columns)
+                    visitNeighbour(cell + columns + 1);
+            }
+
+            first = end;
+        }
+    }
+};
+
+} // namespace Collisions
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include "Simd.hpp"
+
+namespace Geometry {
+
+// Allocator for containers of SIMD types. Storage is aligned to Alignment bytes even where operator new
+// only guarantees less, such as 32 bit targets where it returns 8 byte aligned blocks.
+template <typename T, size_t Alignment = std::max(alignof(T), Simd::alignment)>
+class AlignedAllocator {
+    static_assert(Alignment >= alignof(T), "Alignment can't be lower than the natural alignment of the type.");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, std::max(alignof(U), Alignment)>;
+    };
+
+    constexpr static size_t alignment = Alignment;
+
+    AlignedAllocator() = default;
+
+    template <typename U, size_t OtherAlignment>
+    constexpr AlignedAllocator(const AlignedAllocator<U, OtherAlignment>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    // Stateless, memory from one allocator can be freed by any other
+    template <typename U, size_t OtherAlignment>
+    friend constexpr bool operator==(const AlignedAllocator&, const AlignedAllocator<U, OtherAlignment>&) { return Alignment == OtherAlignment; }
+    template <typename U, size_t OtherAlignment>
+    friend constexpr bool operator!=(const AlignedAllocator& lhs, const AlignedAllocator<U, OtherAlignment>& rhs) { return !(lhs == rhs); }
+};
+
+// Containers of Vector, Matrix or anything holding them, data() is always ready for aligned SIMD loads
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace Geometry
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+#include "Trigonometry.hpp"
+#include "Utility.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+
+// Angle in radians, always wrapped to [-pi, pi]. Sums and differences wrap too, so comparing polar
+// positions never needs the caller to shift anything by 2 pi.
+class Angle {
+    float radians;
+
+public:
+    constexpr Angle()
+        : radians(0.f) {}
+
+    constexpr explicit Angle(float radians)
+        : radians(Wrap(radians)) {}
+
+    constexpr float Radians() const { return radians; }
+
+    SineCosine SinCos() const { return Geometry::SinCos(radians); }
+
+    // Arithmetic operators
+    constexpr Angle operator-() const { return Angle(-radians); }
+    friend constexpr Angle operator+(Angle lhs, Angle rhs) { return Angle(lhs.radians + rhs.radians); }
+    // Signed shortest rotation from rhs to lhs
+    friend constexpr Angle operator-(Angle lhs, Angle rhs) { return Angle(lhs.radians - rhs.radians); }
+    constexpr Angle& operator+=(Angle rhs) { return *this = *this + rhs; }
+    constexpr Angle& operator-=(Angle rhs) { return *this = *this - rhs; }
+
+    // Bool operators
+    friend constexpr bool operator==(Angle lhs, Angle rhs) { return lhs.radians == rhs.radians; }
+    friend constexpr bool operator!=(Angle lhs, Angle rhs) { return lhs.radians != rhs.radians; }
+
+    // Output stream operator
+    friend std::ostream& operator<<(std::ostream& os, Angle angle) {
+        return os << angle.radians;
+    }
+
+    // Static methods
+    // Subtracts the nearest multiple of 2 pi, without a loop or a libm call
+    constexpr static float Wrap(float radians) {
+        const auto turns = static_cast<float>(static_cast<int>(radians * (0.5f / pi) + (radians < 0.f ? -0.5f : 0.5f)));
+        return radians - turns * (2.f * pi);
+    }
+
+    // Polar angle of a point in the XZ plane, Vector<2> holds { x, z } like Vector<3>::To2
+    static Angle Polar(const Vector<2>& point) {
+        return Angle(Atan2(point[1], point[0]));
+    }
+};
+
+// Counterclockwise arc from From() to To(), spanning Width() radians in [0, 2 pi]
+class AngleInterval {
+    Angle from;
+    float width;
+
+public:
+    constexpr AngleInterval()
+        : width(0.f) {}
+
+    constexpr AngleInterval(Angle from, float width)
+        : from(from), width(width) {}
+
+    constexpr Angle From() const { return from; }
+    constexpr Angle To() const { return from + Angle(width); }
+    constexpr Angle Middle() const { return from + Angle(width / 2.f); }
+    constexpr float Width() const { return width; }
+
+    // Counterclockwise rotation from From() to angle in [0, 2 pi). Both angles are already wrapped, so
+    // their difference is within one turn and a single select finishes the job.
+    constexpr float Offset(Angle angle) const {
+        const auto offset = angle.Radians() - from.Radians();
+        return offset < 0.f ? offset + 2.f * pi : offset;
+    }
+
+    constexpr bool Contains(Angle angle) const {
+        return Offset(angle) <= width;
+    }
+
+    constexpr bool Overlaps(const AngleInterval& other) const {
+        return Contains(other.from) || other.Contains(from);
+    }
+
+    // Smallest rotation that brings angle into the interval, zero when it is already inside
+    constexpr float Distance(Angle angle) const {
+        const auto offset = Offset(angle);
+        return offset <= width ? 0.f : std::min(offset - width, 2.f * pi - offset);
+    }
+};
+
+} // namespace Geometry
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <type_traits>
+
+#include "Simd.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+namespace Expression {
+
+// Opt-in expression templates. Lazy(vec) wraps a vector so that chains of element-wise operations build
+// an expression tree instead of temporaries, the whole chain is then evaluated in a single loop.
+// Expressions only reference the wrapped vectors and must be evaluated within the same full expression.
+// Float Vector<3> and Vector<4> expressions are evaluated one SIMD register at a time instead.
+// At -O2 the compiler already fuses the short eager chains the colliders use, the expression benchmarks
+// measure no difference there, so the colliders stay on the eager operators.
+
+template <size_t Size, typename T>
+class Reference {
+    const Vector<Size, T>& vec;
+
+public:
+    constexpr static size_t size = Size;
+    using Scalar = T;
+
+    explicit Reference(const Vector<Size, T>& vec)
+        : vec(vec) {}
+
+    T operator[](size_t index) const { return vec[index]; }
+    Simd::Float4 Packet() const { return Simd::Load(&vec); }
+};
+
+template <typename T>
+class Constant {
+    T value;
+
+public:
+    explicit Constant(T value)
+        : value(value) {}
+
+    T operator[](size_t) const { return value; }
+    Simd::Float4 Packet() const { return Simd::Splat(value); }
+};
+
+struct Add {
+    template <typename T>
+    static T Apply(T lhs, T rhs) { return lhs + rhs; }
+    static Simd::Float4 Apply(Simd::Float4 lhs, Simd::Float4 rhs) { return Simd::Add(lhs, rhs); }
+};
+
+struct Sub {
+    template <typename T>
+    static T Apply(T lhs, T rhs) { return lhs - rhs; }
+    static Simd::Float4 Apply(Simd::Float4 lhs, Simd::Float4 rhs) { return Simd::Sub(lhs, rhs); }
+};
+
+struct Mul {
+    template <typename T>
+    static T Apply(T lhs, T rhs) { return lhs * rhs; }
+    static Simd::Float4 Apply(Simd::Float4 lhs, Simd::Float4 rhs) { return Simd::Mul(lhs, rhs); }
+};
+
+struct Div {
+    template <typename T>
+    static T Apply(T lhs, T rhs) { return lhs / rhs; }
+    static Simd::Float4 Apply(Simd::Float4 lhs, Simd::Float4 rhs) { return Simd::Div(lhs, rhs); }
+};
+
+template <typename E>
+struct IsExpression : std::false_type {};
+
+template <typename Operation, typename Lhs, typename Rhs>
+class Binary {
+    // Size and scalar type come from whichever operand is a vector expression
+    using VectorOperand = std::conditional_t<IsExpression<Lhs>::value, Lhs, Rhs>;
+
+    Lhs lhs;
+    Rhs rhs;
+
+public:
+    constexpr static size_t size = VectorOperand::size;
+    using Scalar = typename VectorOperand::Scalar;
+
+    Binary(const Lhs& lhs, const Rhs& rhs)
+        : lhs(lhs), rhs(rhs) {}
+
+    Scalar operator[](size_t index) const { return Operation::Apply(lhs[index], rhs[index]); }
+    Simd::Float4 Packet() const { return Operation::Apply(lhs.Packet(), rhs.Packet()); }
+
+    Vector<size, Scalar> Eval() const {
+        Vector<size, Scalar> ret;
+        if constexpr (size >= 3 && std::is_same_v<Scalar, float>) {
+            Simd::Store(&ret[0], Packet());
+        } else {
+            for (size_t i = 0; i < size; ++i)
+                ret[i] = (*this)[i];
+        }
+        return ret;
+    }
+
+    operator Vector<size, Scalar>() const { return Eval(); }
+};
+
+template <size_t Size, typename T>
+struct IsExpression<Reference<Size, T>> : std::true_type {};
+
+template <typename Operation, typename Lhs, typename Rhs>
+struct IsExpression<Binary<Operation, Lhs, Rhs>> : std::true_type {};
+
+template <typename Lhs, typename Rhs>
+using EnableBothExpressions = std::enable_if_t<IsExpression<Lhs>::value && IsExpression<Rhs>::value>;
+
+template <typename E>
+using EnableExpression = std::enable_if_t<IsExpression<E>::value>;
+
+// Expression arithmetic operators
+template <typename Lhs, typename Rhs, typename = EnableBothExpressions<Lhs, Rhs>>
+Binary<Add, Lhs, Rhs> operator+(const Lhs& lhs, const Rhs& rhs) { return { lhs, rhs }; }
+template <typename Lhs, typename Rhs, typename = EnableBothExpressions<Lhs, Rhs>>
+Binary<Sub, Lhs, Rhs> operator-(const Lhs& lhs, const Rhs& rhs) { return { lhs, rhs }; }
+template <typename Lhs, typename Rhs, typename = EnableBothExpressions<Lhs, Rhs>>
+Binary<Mul, Lhs, Rhs> operator*(const Lhs& lhs, const Rhs& rhs) { return { lhs, rhs }; }
+template <typename Lhs, typename Rhs, typename = EnableBothExpressions<Lhs, Rhs>>
+Binary<Div, Lhs, Rhs> operator/(const Lhs& lhs, const Rhs& rhs) { return { lhs, rhs }; }
+
+// Scalar arithmetic operators
+template <typename E, typename = EnableExpression<E>>
+Binary<Add, E, Constant<typename E::Scalar>> operator+(const E& expr, typename E::Scalar scalar) { return { expr, Constant<typename E::Scalar>(scalar) }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Sub, E, Constant<typename E::Scalar>> operator-(const E& expr, typename E::Scalar scalar) { return { expr, Constant<typename E::Scalar>(scalar) }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Mul, E, Constant<typename E::Scalar>> operator*(const E& expr, typename E::Scalar scalar) { return { expr, Constant<typename E::Scalar>(scalar) }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Div, E, Constant<typename E::Scalar>> operator/(const E& expr, typename E::Scalar scalar) { return { expr, Constant<typename E::Scalar>(scalar) }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Add, Constant<typename E::Scalar>, E> operator+(typename E::Scalar scalar, const E& expr) { return { Constant<typename E::Scalar>(scalar), expr }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Sub, Constant<typename E::Scalar>, E> operator-(typename E::Scalar scalar, const E& expr) { return { Constant<typename E::Scalar>(scalar), expr }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Mul, Constant<typename E::Scalar>, E> operator*(typename E::Scalar scalar, const E& expr) { return { Constant<typename E::Scalar>(scalar), expr }; }
+template <typename E, typename = EnableExpression<E>>
+Binary<Div, Constant<typename E::Scalar>, E> operator/(typename E::Scalar scalar, const E& expr) { return { Constant<typename E::Scalar>(scalar), expr }; }
+
+} // namespace Expression
+
+template <size_t Size, typename T>
+Expression::Reference<Size, T> Lazy(const Vector<Size, T>& vec) {
+    return Expression::Reference<Size, T>(vec);
+}
+
+} // namespace Geometry
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <ostream>
+
+namespace Geometry {
+
+// Q16.16 fixed point scalar for Vector<Size, Fixed> and Matrix<Width, Fixed>. Every operation, including
+// the math functions below, uses integer arithmetic only, so results are bit identical on every machine.
+// Values range from -32768 to 32768 with a resolution of 1 / 65536. Conversions and arithmetic saturate at
+// the ends of that range instead of wrapping around, so a squared distance that overflows still compares
+// greater than any radius.
+class Fixed {
+    int32_t raw;
+
+    constexpr static int fractionBits = 16;
+    constexpr static int32_t one = 1 << fractionBits;
+    constexpr static int32_t rawPi = 205887;
+    constexpr static int32_t rawHalfPi = 102944;
+    constexpr static int32_t rawTwoPi = 411775;
+
+    // Intermediate results of the math functions keep 30 fraction bits
+    constexpr static int wideBits = 30;
+    constexpr static int64_t wideOne = int64_t(1) << wideBits;
+    constexpr static int64_t widePi = 3373259426;
+    // atan(2^-i) for the CORDIC iterations of atan2
+    constexpr static int64_t atanTable[] = {
+        843314857, 497837829, 263043837, 133525159, 67021687, 33543516, 16775851, 8388437, 4194283, 2097149,
+        1048576, 524288, 262144, 131072, 65536, 32768, 16384, 8192, 4096, 2048,
+        1024, 512, 256, 128, 64, 32, 16, 8, 4, 2
+    };
+
+    constexpr static Fixed Saturated(int64_t value) {
+        return FromRaw(static_cast<int32_t>(std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max())));
+    }
+
+    constexpr static int32_t FromWide(int64_t value) {
+        return static_cast<int32_t>((value + (int64_t(1) << (wideBits - fractionBits - 1))) >> (wideBits - fractionBits));
+    }
+
+    // Sine of a raw angle of any magnitude
+    constexpr static int32_t Sine(int64_t angle) {
+        // Reduce to [-pi, pi], then to [-pi / 2, pi / 2] through sin(pi - x) == sin(x)
+        angle %= rawTwoPi;
+        if (angle > rawPi)
+            angle -= rawTwoPi;
+        else if (angle < -rawPi)
+            angle += rawTwoPi;
+        if (angle > rawHalfPi)
+            angle = rawPi - angle;
+        else if (angle < -rawHalfPi)
+            angle = -rawPi - angle;
+
+        // Taylor series up to x^11 in Horner form
+        const auto x = angle * (int64_t(1) << (wideBits - fractionBits));
+        const auto square = (x * x) >> wideBits;
+        auto sum = wideOne;
+        for (const int64_t divisor : { 110, 72, 42, 20, 6 })
+            sum = wideOne - ((square * sum) >> wideBits) / divisor;
+        return FromWide((x * sum) >> wideBits);
+    }
+
+public:
+    constexpr Fixed()
+        : raw(0) {}
+
+    constexpr explicit Fixed(int value)
+        : raw(Saturated(static_cast<int64_t>(value) * one).raw) {}
+
+    constexpr explicit Fixed(double value)
+        : raw(Saturated(static_cast<int64_t>(std::clamp(value * one + (value < 0 ? -0.5 : 0.5), -2147483648.0, 2147483647.0))).raw) {}
+
+    constexpr explicit Fixed(float value)
+        : Fixed(static_cast<double>(value)) {}
+
+    constexpr int32_t Raw() const { return raw; }
+
+    constexpr explicit operator float() const { return static_cast<float>(raw) / one; }
+    constexpr explicit operator double() const { return static_cast<double>(raw) / one; }
+
+    // Arithmetic operators
+    constexpr Fixed operator-() const { return Saturated(-static_cast<int64_t>(raw)); }
+    friend constexpr Fixed operator+(Fixed lhs, Fixed rhs) { return Saturated(static_cast<int64_t>(lhs.raw) + rhs.raw); }
+    friend constexpr Fixed operator-(Fixed lhs, Fixed rhs) { return Saturated(static_cast<int64_t>(lhs.raw) - rhs.raw); }
+
+    // Products are rounded to nearest
+    friend constexpr Fixed operator*(Fixed lhs, Fixed rhs) {
+        const auto product = static_cast<int64_t>(lhs.raw) * rhs.raw;
+        return Saturated((product + one / 2) >> fractionBits);
+    }
+
+    // Quotients are truncated towards zero, division by zero saturates
+    friend constexpr Fixed operator/(Fixed lhs, Fixed rhs) {
+        if (rhs.raw == 0)
+            return FromRaw(lhs.raw < 0 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max());
+        return Saturated(static_cast<int64_t>(lhs.raw) * one / rhs.raw);
+    }
+
+    constexpr Fixed& operator+=(Fixed rhs) { return *this = *this + rhs; }
+    constexpr Fixed& operator-=(Fixed rhs) { return *this = *this - rhs; }
+    constexpr Fixed& operator*=(Fixed rhs) { return *this = *this * rhs; }
+    constexpr Fixed& operator/=(Fixed rhs) { return *this = *this / rhs; }
+
+    // Bool operators
+    friend constexpr bool operator==(Fixed lhs, Fixed rhs) { return lhs.raw == rhs.raw; }
+    friend constexpr bool operator!=(Fixed lhs, Fixed rhs) { return lhs.raw != rhs.raw; }
+    friend constexpr bool operator<(Fixed lhs, Fixed rhs) { return lhs.raw < rhs.raw; }
+    friend constexpr bool operator>(Fixed lhs, Fixed rhs) { return lhs.raw > rhs.raw; }
+    friend constexpr bool operator<=(Fixed lhs, Fixed rhs) { return lhs.raw <= rhs.raw; }
+    friend constexpr bool operator>=(Fixed lhs, Fixed rhs) { return lhs.raw >= rhs.raw; }
+
+    // Math functions, found through argument dependent lookup like their std counterparts
+    friend constexpr Fixed abs(Fixed value) {
+        return value.raw < 0 ? -value : value;
+    }
+
+    // Rounded down, negative values give zero
+    friend constexpr Fixed sqrt(Fixed value) {
+        if (value.raw <= 0)
+            return Fixed();
+        // Integer square root of raw << 16 is the square root in Q16.16
+        auto remainder = static_cast<uint64_t>(value.raw) << fractionBits;
+        uint64_t root = 0;
+        auto bit = uint64_t(1) << 62;
+        while (bit > remainder)
+            bit >>= 2;
+        while (bit != 0) {
+            if (remainder >= root + bit) {
+                remainder -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        return FromRaw(static_cast<int32_t>(root));
+    }
+
+    friend constexpr Fixed sin(Fixed angle) {
+        return FromRaw(Sine(angle.raw));
+    }
+
+    friend constexpr Fixed cos(Fixed angle) {
+        return FromRaw(Sine(static_cast<int64_t>(angle.raw % rawTwoPi) + rawHalfPi));
+    }
+
+    // CORDIC in vectoring mode, accurate to a few units of the last place
+    friend constexpr Fixed atan2(Fixed y, Fixed x) {
+        if (x.raw == 0 && y.raw == 0)
+            return Fixed();
+
+        int64_t vx = x.raw;
+        int64_t vy = y.raw;
+        int64_t angle = 0;
+        // CORDIC only converges within +-pi / 2, so start from the right half plane
+        if (vx < 0) {
+            angle = vy < 0 ? -widePi : widePi;
+            vx = -vx;
+            vy = -vy;
+        }
+        // Scale up so the shifts below keep enough precision
+        while (std::max(vx, vy < 0 ? -vy : vy) < (int64_t(1) << 59)) {
+            vx *= 2;
+            vy *= 2;
+        }
+
+        // Rotate the vector onto the x axis, summing the rotation angles
+        for (int i = 0; i < 30; ++i) {
+            const auto dx = vx >> i;
+            const auto dy = vy >> i;
+            if (vy > 0) {
+                vx += dy;
+                vy -= dx;
+                angle += atanTable[i];
+            } else {
+                vx -= dy;
+                vy += dx;
+                angle -= atanTable[i];
+            }
+        }
+        return FromRaw(FromWide(angle));
+    }
+
+    // Output stream operator
+    friend std::ostream& operator<<(std::ostream& os, Fixed value) {
+        return os << static_cast<double>(value);
+    }
+
+    // Static methods
+    constexpr static Fixed FromRaw(int32_t value) {
+        Fixed ret;
+        ret.raw = value;
+        return ret;
+    }
+};
+
+} // namespace Geometry
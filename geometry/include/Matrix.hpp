@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <ostream>
+#include <type_traits>
 
 #include "Exceptions.hpp"
+#include "Parallel.hpp"
 #include "Vector.hpp"
 
 namespace Geometry {
@@ -13,73 +17,67 @@ class Row {
     T* data;
     size_t x;
 
-    template <size_t W>
+    template <size_t W, typename U>
     friend class Matrix;
-    Row(T* data, size_t x)
+    constexpr Row(T* data, size_t x)
         : data(data), x(x) {}
 
 public:
     // Index operators
-    T& operator[](size_t y) { return data[Width * y + x]; }
-    T operator[](size_t y) const { return data[Width * y + x]; }
+    constexpr T& operator[](size_t y) { return data[Width * y + x]; }
+    constexpr T operator[](size_t y) const { return data[Width * y + x]; }
 };
 
-template <size_t Width>
+template <size_t Width, typename T = float>
+class LUDecomposition;
+
+// Scalar type defaults to float, other types such as double or Fixed share the same code
+template <size_t Width, typename T = float>
 class Matrix {
     static_assert(Width >= 2, "Matrix of size lesser than 2 is not supported.");
     constexpr static size_t size = Width * Width;
 
-    using ConstRow = const Row<const float, Width>;
-    using NormalRow = Row<float, Width>;
+    using ConstRow = const Row<const T, Width>;
+    using NormalRow = Row<T, Width>;
+
+    // Float Matrix<4> rows are single aligned SIMD registers
+    constexpr static bool simd = Width == 4 && std::is_same_v<T, float>;
 
-    std::array<float, size> data;
+    alignas(simd ? Simd::alignment : alignof(T)) std::array<T, size> data;
 
 public:
+    using Scalar = T;
+
     Matrix() = default;
-    Matrix(float value)
+    constexpr Matrix(T value)
         : data() {
         for (size_t i = 0; i < size; ++i) {
             data[i] = value;
         }
     }
 
-    Matrix(const std::initializer_list<float>& list)
-        : data() {
-        if (list.size() != size)
-            throw std::invalid_argument("Can't initialize with list of size " + std::to_string(list.size()) + ". Size must be " + std::to_string(size) + ".");
-
-        unsigned i = 0;
-        unsigned j = 0;
-        for (auto item : list) {
-            (*this)[i][j] = item;
-            ++i;
-            if (i >= Width) {
-                i = 0;
-                ++j;
-            }
-        }
-    }
+    // Elements are listed row by row, the count is checked at compile time
+    template <typename... Elements, typename = std::enable_if_t<sizeof...(Elements) == size && std::conjunction_v<std::is_constructible<T, Elements>...>>>
+    constexpr Matrix(Elements... elements)
+        : data{ static_cast<T>(elements)... } {}
 
-    Matrix& Translate(const Vector<Width - 1>& dimensions) { throw DimensionsException<Width>("Matrix", "Translate"); }
-    Matrix& Rotate(float angle, Vector<Width - 1> axis) { throw DimensionsException<Width>("Matrix", "Rotate"); }
-    Matrix& Scale(const Vector<Width - 1>& dimensions) { throw DimensionsException<Width>("Matrix", "Scale"); }
+    // Only supported by Matrix<4>
+    Matrix& Translate(const Vector<Width - 1, T>& dimensions);
+    Matrix& Rotate(T angle, Vector<Width - 1, T> axis);
+    Matrix& Rotate(const Rotation&) { throw DimensionsException<Width>("Matrix", "Rotate"); }
+    Matrix& Scale(const Vector<Width - 1, T>& dimensions);
 
-    int Determinant() const {
-        float det = 0;
-        for (size_t i = 0; i < Width; ++i)
-            det += (i % 2 == 0 ? 1 : -1) * data[i] * Minor(0, i).Determinant();
-        return det;
-    }
+    T Determinant() const;
 
-    Matrix<Width - 1> Minor(size_t row, size_t column) const {
-        Matrix<Width - 1> minor;
+    Matrix<Width - 1, T> Minor(size_t row, size_t column) const {
+        Matrix<Width - 1, T> minor;
         for (size_t j = 0, l = 0; j < Width; ++j) {
             if (j == row)
                 continue;
             for (size_t i = 0, k = 0; i < Width; ++i) {
                 if (i == column)
                     continue;
-                minor[k][l] = (*this)[i][j];
+                minor.At(l, k) = At(j, i);
                 ++k;
             }
             ++l;
@@ -88,9 +86,21 @@ public:
     }
 
     Matrix& Transpose() {
-        for (size_t j = 1; j < Width; ++j)
-            for (size_t i = 0; i < j; ++i)
-                std::swap((*this)[i][j], (*this)[j][i]);
+        if constexpr (simd) {
+            auto row0 = Simd::Load(RowData(0));
+            auto row1 = Simd::Load(RowData(1));
+            auto row2 = Simd::Load(RowData(2));
+            auto row3 = Simd::Load(RowData(3));
+            Simd::Transpose(row0, row1, row2, row3);
+            Simd::Store(RowData(0), row0);
+            Simd::Store(RowData(1), row1);
+            Simd::Store(RowData(2), row2);
+            Simd::Store(RowData(3), row3);
+        } else {
+            for (size_t j = 1; j < Width; ++j)
+                for (size_t i = 0; i < j; ++i)
+                    std::swap(At(i, j), At(j, i));
+        }
         return *this;
     }
 
@@ -98,19 +108,46 @@ public:
         for (size_t j = 0; j < Width; ++j)
             for (size_t i = 0; i < Width; ++i)
                 if (i % 2 != j % 2)
-                    (*this)[i][j] *= -1;
+                    At(j, i) = -At(j, i);
         return *this;
     }
 
-    Matrix& Invert() {
-        return *this = Matrix::Minors(*this).Cofactor().Transpose() / Determinant();
+    Matrix& Invert();
+
+    // Solves x * matrix == rhs
+    std::array<T, Width> Solve(const std::array<T, Width>& rhs) const {
+        return LUDecomposition<Width, T>(*this).Solve(rhs);
+    }
+
+    // Inverse of a transform whose bottom row is { 0, 0, 0, 1 }, only supported by Matrix<4>
+    Matrix& InvertAffine();
+
+    // Transform count contiguous elements the way the model matrix does in the shader, which is
+    // vec * Transposed(matrix). Points get w = 1, normals go through the inverse transpose and are
+    // renormalized. Only supported by Matrix<4>. Work is split over threadCount threads, 0 uses every
+    // hardware thread, and out may alias the input.
+    void Transform(const Vector<Width, T>* vectors, size_t count, Vector<Width, T>* out, unsigned threadCount = 1) const;
+    void TransformPoints(const Vector<Width - 1, T>* points, size_t count, Vector<Width - 1, T>* out, unsigned threadCount = 1) const;
+    void TransformNormals(const Vector<Width - 1, T>* normals, size_t count, Vector<Width - 1, T>* out, unsigned threadCount = 1) const;
+
+    // Raw accessors without the Row proxy of the index operators, note the row comes first here
+    constexpr T& At(size_t row, size_t column) { return data[Width * row + column]; }
+    constexpr const T& At(size_t row, size_t column) const { return data[Width * row + column]; }
+    // Rows are contiguous, Width elements each
+    T* RowData(size_t row) { return &data[Width * row]; }
+    const T* RowData(size_t row) const { return &data[Width * row]; }
+    Vector<Width, T> Column(size_t column) const {
+        Vector<Width, T> ret;
+        for (size_t row = 0; row < Width; ++row)
+            ret[row] = At(row, column);
+        return ret;
     }
 
     // Index operators
-    NormalRow operator[](size_t x) { return { data.data(), x }; }
-    ConstRow operator[](size_t x) const { return { data.data(), x }; }
+    constexpr NormalRow operator[](size_t x) { return { data.data(), x }; }
+    constexpr ConstRow operator[](size_t x) const { return { data.data(), x }; }
     // Dereference operator
-    const float* operator&() const { return &data[0]; }
+    const T* operator&() const { return &data[0]; }
     // Bool operators
     friend bool operator==(const Matrix& lhs, const Matrix& rhs) { return lhs.data == rhs.data; }
     friend bool operator!=(const Matrix& lhs, const Matrix& rhs) { return lhs.data != rhs.data; }
@@ -132,38 +169,50 @@ public:
     }
 
     friend Matrix operator*(const Matrix& lhs, const Matrix& rhs) {
-        Matrix out;
-        for (size_t j = 0; j < Width; ++j)
-            for (size_t i = 0; i < Width; ++i) {
-                float sum = 0.f;
-                for (size_t k = 0; k < Width; ++k)
-                    sum += lhs[k][j] * rhs[i][k];
-                out[i][j] = sum;
+        if constexpr (simd) {
+            // Every output row is the rhs rows scaled by one lhs row, summed in the same order as below
+            Matrix out;
+            for (size_t row = 0; row < 4; ++row) {
+                auto sum = Simd::Mul(Simd::Splat(lhs.At(row, 0)), Simd::Load(rhs.RowData(0)));
+                for (size_t k = 1; k < 4; ++k)
+                    sum = Simd::Add(sum, Simd::Mul(Simd::Splat(lhs.At(row, k)), Simd::Load(rhs.RowData(k))));
+                Simd::Store(out.RowData(row), sum);
             }
-        return out;
+            return out;
+        } else {
+            Matrix out;
+            for (size_t row = 0; row < Width; ++row)
+                for (size_t column = 0; column < Width; ++column) {
+                    auto sum = T(0);
+                    for (size_t k = 0; k < Width; ++k)
+                        sum += lhs.At(row, k) * rhs.At(k, column);
+                    out.At(row, column) = sum;
+                }
+            return out;
+        }
     }
 
-    friend Matrix operator*(Matrix matrix, float value) {
-        for (size_t j = 0; j < Width; ++j)
-            for (size_t i = 0; i < Width; ++i)
-                matrix[i][j] *= value;
+    friend Matrix operator*(Matrix matrix, T value) {
+        for (auto& i : matrix.data)
+            i *= value;
         return matrix;
     }
 
-    friend Matrix operator/(Matrix matrix, float value) {
-        for (size_t j = 0; j < Width; ++j)
-            for (size_t i = 0; i < Width; ++i)
-                matrix[i][j] /= value;
+    friend Matrix operator/(Matrix matrix, T value) {
+        for (auto& i : matrix.data)
+            i /= value;
         return matrix;
     }
 
     // Matrix-Vector multiplication
-    friend Vector<Width> operator*(const Vector<Width>& vec, const Matrix& mat) {
-        Vector<Width> ret;
-        for (unsigned i = 0; i < Width; ++i) {
-            float sum = 0;
-            for (unsigned j = 0; j < Width; ++j) {
-                sum += vec[j] * mat[j][i];
+    // Deduced so that matrices wider than any Vector never instantiate one during overload resolution
+    template <size_t Size, typename = std::enable_if_t<Size == Width>>
+    friend Vector<Size, T> operator*(const Vector<Size, T>& vec, const Matrix& mat) {
+        Vector<Size, T> ret;
+        for (size_t i = 0; i < Width; ++i) {
+            auto sum = T(0);
+            for (size_t j = 0; j < Width; ++j) {
+                sum += vec[j] * mat.At(i, j);
             }
             ret[i] = sum;
         }
@@ -179,10 +228,10 @@ public:
     }
 
     // Static methods
-    static Matrix Identity() {
-        auto ret = Matrix();
+    constexpr static Matrix Identity() {
+        auto ret = Matrix(T(0));
         for (size_t i = 0; i < Width; ++i) {
-            ret[i][i] = 1.f;
+            ret.At(i, i) = T(1);
         }
         return ret;
     }
@@ -191,11 +240,35 @@ public:
         return mat.Transpose();
     }
 
+    // Transposed(lhs) * rhs without building the transpose
+    static Matrix TransposedMultiply(const Matrix& lhs, const Matrix& rhs) {
+        if constexpr (simd) {
+            Matrix out;
+            for (size_t row = 0; row < 4; ++row) {
+                auto sum = Simd::Mul(Simd::Splat(lhs.At(0, row)), Simd::Load(rhs.RowData(0)));
+                for (size_t k = 1; k < 4; ++k)
+                    sum = Simd::Add(sum, Simd::Mul(Simd::Splat(lhs.At(k, row)), Simd::Load(rhs.RowData(k))));
+                Simd::Store(out.RowData(row), sum);
+            }
+            return out;
+        } else {
+            Matrix out;
+            for (size_t row = 0; row < Width; ++row)
+                for (size_t column = 0; column < Width; ++column) {
+                    auto sum = T(0);
+                    for (size_t k = 0; k < Width; ++k)
+                        sum += lhs.At(k, row) * rhs.At(k, column);
+                    out.At(row, column) = sum;
+                }
+            return out;
+        }
+    }
+
     static Matrix Minors(const Matrix& matrix) {
         Matrix minors;
         for (size_t j = 0; j < Width; ++j)
             for (size_t i = 0; i < Width; ++i)
-                minors[i][j] = matrix.Minor(j, i).Determinant();
+                minors.At(j, i) = matrix.Minor(j, i).Determinant();
         return minors;
     }
 
@@ -206,52 +279,318 @@ public:
     static Matrix Inverted(Matrix matrix) {
         return matrix.Invert();
     }
+
+    static Matrix InvertedAffine(Matrix matrix) {
+        return matrix.InvertAffine();
+    }
 };
 
-template <>
-inline int Matrix<2>::Determinant() const {
-    return static_cast<int>(std::round(data[0] * data[3] - data[1] * data[2]));
+static_assert(alignof(Matrix<4>) == Simd::alignment, "Matrix<4> rows must be aligned SIMD registers.");
+
+// LU decomposition with partial pivoting, O(n^3) determinant, solve and inverse for any size
+template <size_t Width, typename T>
+class LUDecomposition {
+    // Row major, data[Width * row + column], unit lower triangle is implicit
+    std::array<T, Width * Width> lu;
+    std::array<size_t, Width> permutation;
+    T sign = T(1);
+    bool singular = false;
+
+public:
+    explicit LUDecomposition(const Matrix<Width, T>& matrix) {
+        using std::abs;
+        const T* data = &matrix;
+        std::copy(data, data + Width * Width, lu.begin());
+        for (size_t i = 0; i < Width; ++i)
+            permutation[i] = i;
+
+        for (size_t k = 0; k < Width; ++k) {
+            size_t pivot = k;
+            for (size_t i = k + 1; i < Width; ++i)
+                if (abs(lu[Width * i + k]) > abs(lu[Width * pivot + k]))
+                    pivot = i;
+
+            if (lu[Width * pivot + k] == T(0)) {
+                singular = true;
+                continue;
+            }
+
+            if (pivot != k) {
+                std::swap_ranges(lu.begin() + Width * k, lu.begin() + Width * (k + 1), lu.begin() + Width * pivot);
+                std::swap(permutation[k], permutation[pivot]);
+                sign = -sign;
+            }
+
+            for (size_t i = k + 1; i < Width; ++i) {
+                const auto factor = lu[Width * i + k] /= lu[Width * k + k];
+                for (size_t j = k + 1; j < Width; ++j)
+                    lu[Width * i + j] -= factor * lu[Width * k + j];
+            }
+        }
+    }
+
+    bool IsSingular() const { return singular; }
+
+    T Determinant() const {
+        if (singular)
+            return T(0);
+        auto det = sign;
+        for (size_t i = 0; i < Width; ++i)
+            det *= lu[Width * i + i];
+        return det;
+    }
+
+    std::array<T, Width> Solve(const std::array<T, Width>& rhs) const {
+        std::array<T, Width> x;
+        // Forward substitution with the permuted right hand side
+        for (size_t i = 0; i < Width; ++i) {
+            auto sum = rhs[permutation[i]];
+            for (size_t j = 0; j < i; ++j)
+                sum -= lu[Width * i + j] * x[j];
+            x[i] = sum;
+        }
+        // Back substitution
+        for (size_t i = Width; i-- > 0;) {
+            auto sum = x[i];
+            for (size_t j = i + 1; j < Width; ++j)
+                sum -= lu[Width * i + j] * x[j];
+            x[i] = sum / lu[Width * i + i];
+        }
+        return x;
+    }
+
+    Matrix<Width, T> Inverse() const {
+        Matrix<Width, T> inverse;
+        std::array<T, Width> unit{};
+        for (size_t i = 0; i < Width; ++i) {
+            unit[i] = T(1);
+            const auto column = Solve(unit);
+            for (size_t j = 0; j < Width; ++j)
+                inverse[i][j] = column[j];
+            unit[i] = T(0);
+        }
+        return inverse;
+    }
+};
+
+template <size_t Width, typename T>
+T Matrix<Width, T>::Determinant() const {
+    if constexpr (Width == 2) {
+        return data[0] * data[3] - data[1] * data[2];
+    } else if constexpr (Width == 4) {
+        // Closed form through the 2x2 sub-determinants of the top and bottom halves
+        const auto& m = data;
+        const auto s0 = m[0] * m[5] - m[4] * m[1];
+        const auto s1 = m[0] * m[6] - m[4] * m[2];
+        const auto s2 = m[0] * m[7] - m[4] * m[3];
+        const auto s3 = m[1] * m[6] - m[5] * m[2];
+        const auto s4 = m[1] * m[7] - m[5] * m[3];
+        const auto s5 = m[2] * m[7] - m[6] * m[3];
+
+        const auto c5 = m[10] * m[15] - m[14] * m[11];
+        const auto c4 = m[9] * m[15] - m[13] * m[11];
+        const auto c3 = m[9] * m[14] - m[13] * m[10];
+        const auto c2 = m[8] * m[15] - m[12] * m[11];
+        const auto c1 = m[8] * m[14] - m[12] * m[10];
+        const auto c0 = m[8] * m[13] - m[12] * m[9];
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    } else if constexpr (Width > 4) {
+        return LUDecomposition<Width, T>(*this).Determinant();
+    } else {
+        auto det = T(0);
+        for (size_t i = 0; i < Width; ++i) {
+            const auto term = data[i] * Minor(0, i).Determinant();
+            det = i % 2 == 0 ? det + term : det - term;
+        }
+        return det;
+    }
 }
 
-template <>
-inline Matrix<4>& Matrix<4>::Translate(const Vector<3>& dimensions) {
-    Matrix translation = Identity();
-    translation[0][3] = dimensions.X();
-    translation[1][3] = dimensions.Y();
-    translation[2][3] = dimensions.Z();
-    return *this = *this * translation;
+template <size_t Width, typename T>
+Matrix<Width, T>& Matrix<Width, T>::Invert() {
+    if constexpr (Width == 4) {
+        // Closed form through the same sub-determinants as Determinant
+        const auto m = data;
+        const auto s0 = m[0] * m[5] - m[4] * m[1];
+        const auto s1 = m[0] * m[6] - m[4] * m[2];
+        const auto s2 = m[0] * m[7] - m[4] * m[3];
+        const auto s3 = m[1] * m[6] - m[5] * m[2];
+        const auto s4 = m[1] * m[7] - m[5] * m[3];
+        const auto s5 = m[2] * m[7] - m[6] * m[3];
+
+        const auto c5 = m[10] * m[15] - m[14] * m[11];
+        const auto c4 = m[9] * m[15] - m[13] * m[11];
+        const auto c3 = m[9] * m[14] - m[13] * m[10];
+        const auto c2 = m[8] * m[15] - m[12] * m[11];
+        const auto c1 = m[8] * m[14] - m[12] * m[10];
+        const auto c0 = m[8] * m[13] - m[12] * m[9];
+
+        const auto det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+        // Adjugate entries are divided by the determinant one by one to keep integer inputs exact
+        data[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) / det;
+        data[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) / det;
+        data[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) / det;
+        data[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) / det;
+
+        data[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) / det;
+        data[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) / det;
+        data[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) / det;
+        data[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) / det;
+
+        data[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) / det;
+        data[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) / det;
+        data[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) / det;
+        data[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) / det;
+
+        data[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) / det;
+        data[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) / det;
+        data[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) / det;
+        data[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) / det;
+        return *this;
+    } else if constexpr (Width > 4) {
+        return *this = LUDecomposition<Width, T>(*this).Inverse();
+    } else {
+        return *this = Matrix::Minors(*this).Cofactor().Transpose() / Determinant();
+    }
 }
 
-template <>
-inline Matrix<4>& Matrix<4>::Rotate(float angle, Vector<3> axis) {
-    float const c = cos(angle);
-    float const s = sin(angle);
+template <size_t Width, typename T>
+Matrix<Width, T>& Matrix<Width, T>::InvertAffine() {
+    if constexpr (Width == 4) {
+        // Only the 3x3 linear part needs a real inverse, translation is transformed by it
+        const auto m = data;
+        const auto c0 = m[5] * m[10] - m[9] * m[6];
+        const auto c1 = m[9] * m[2] - m[1] * m[10];
+        const auto c2 = m[1] * m[6] - m[5] * m[2];
+        const auto det = m[0] * c0 + m[4] * c1 + m[8] * c2;
+
+        data[0] = c0 / det;
+        data[1] = c1 / det;
+        data[2] = c2 / det;
+        data[4] = (m[8] * m[6] - m[4] * m[10]) / det;
+        data[5] = (m[0] * m[10] - m[8] * m[2]) / det;
+        data[6] = (m[4] * m[2] - m[0] * m[6]) / det;
+        data[8] = (m[4] * m[9] - m[8] * m[5]) / det;
+        data[9] = (m[8] * m[1] - m[0] * m[9]) / det;
+        data[10] = (m[0] * m[5] - m[4] * m[1]) / det;
+
+        data[12] = -(data[0] * m[12] + data[4] * m[13] + data[8] * m[14]);
+        data[13] = -(data[1] * m[12] + data[5] * m[13] + data[9] * m[14]);
+        data[14] = -(data[2] * m[12] + data[6] * m[13] + data[10] * m[14]);
+        return *this;
+    } else {
+        throw DimensionsException<Width>("Matrix", "InvertAffine");
+    }
+}
 
-    axis.Normalize();
-    Vector<3> temp = axis * (1.f - c);
+template <size_t Width, typename T>
+void Matrix<Width, T>::Transform(const Vector<Width, T>* vectors, size_t count, Vector<Width, T>* out, unsigned threadCount) const {
+    if constexpr (Width == 4) {
+        // Rows are scaled by the components and summed in the same order as operator*, so results are
+        // bit identical. Float rows are single SIMD registers.
+        const Vector<4, T> rows[] = { { data[0], data[1], data[2], data[3] }, { data[4], data[5], data[6], data[7] },
+                                      { data[8], data[9], data[10], data[11] }, { data[12], data[13], data[14], data[15] } };
+        Parallel::For(count, threadCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto vec = vectors[i];
+                out[i] = rows[0] * vec[0] + rows[1] * vec[1] + rows[2] * vec[2] + rows[3] * vec[3];
+            }
+        });
+    } else {
+        throw DimensionsException<Width>("Matrix", "Transform");
+    }
+}
 
-    Matrix rotation = Identity();
-    rotation[0][0] = c + temp[0] * axis[0];
-    rotation[1][0] = temp[0] * axis[1] + s * axis[2];
-    rotation[2][0] = temp[0] * axis[2] - s * axis[1];
+template <size_t Width, typename T>
+void Matrix<Width, T>::TransformPoints(const Vector<Width - 1, T>* points, size_t count, Vector<Width - 1, T>* out, unsigned threadCount) const {
+    if constexpr (Width == 4) {
+        const Vector<4, T> rows[] = { { data[0], data[1], data[2], data[3] }, { data[4], data[5], data[6], data[7] },
+                                      { data[8], data[9], data[10], data[11] }, { data[12], data[13], data[14], data[15] } };
+        Parallel::For(count, threadCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto point = points[i];
+                out[i] = (rows[0] * point[0] + rows[1] * point[1] + rows[2] * point[2] + rows[3]).To3();
+            }
+        });
+    } else {
+        throw DimensionsException<Width>("Matrix", "TransformPoints");
+    }
+}
 
-    rotation[0][1] = temp[1] * axis[0] - s * axis[2];
-    rotation[1][1] = c + temp[1] * axis[1];
-    rotation[2][1] = temp[1] * axis[2] + s * axis[0];
+template <size_t Width, typename T>
+void Matrix<Width, T>::TransformNormals(const Vector<Width - 1, T>* normals, size_t count, Vector<Width - 1, T>* out, unsigned threadCount) const {
+    if constexpr (Width == 4) {
+        // The linear part has the first three rows as its columns. Rows of its inverse are cross products
+        // of those columns over the determinant, so they are the rows of the inverse transpose too.
+        const Vector<3, T> axes[] = { { data[0], data[1], data[2] }, { data[4], data[5], data[6] }, { data[8], data[9], data[10] } };
+        const Vector<3, T> crosses[] = { Vector<3, T>::Cross(axes[1], axes[2]), Vector<3, T>::Cross(axes[2], axes[0]), Vector<3, T>::Cross(axes[0], axes[1]) };
+        const auto det = Vector<3, T>::Dot(axes[0], crosses[0]);
+        const Vector<3, T> rows[] = { crosses[0] / det, crosses[1] / det, crosses[2] / det };
+
+        Parallel::For(count, threadCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto normal = normals[i];
+                out[i] = (rows[0] * normal[0] + rows[1] * normal[1] + rows[2] * normal[2]).Normalize();
+            }
+        });
+    } else {
+        throw DimensionsException<Width>("Matrix", "TransformNormals");
+    }
+}
+
+template <size_t Width, typename T>
+Matrix<Width, T>& Matrix<Width, T>::Translate(const Vector<Width - 1, T>& dimensions) {
+    if constexpr (Width == 4) {
+        Matrix translation = Identity();
+        translation.At(3, 0) = dimensions.X();
+        translation.At(3, 1) = dimensions.Y();
+        translation.At(3, 2) = dimensions.Z();
+        return *this = *this * translation;
+    } else {
+        throw DimensionsException<Width>("Matrix", "Translate");
+    }
+}
+
+template <size_t Width, typename T>
+Matrix<Width, T>& Matrix<Width, T>::Rotate(T angle, Vector<Width - 1, T> axis) {
+    if constexpr (Width == 4) {
+        T const c = static_cast<T>(cos(angle));
+        T const s = static_cast<T>(sin(angle));
 
-    rotation[0][2] = temp[2] * axis[0] + s * axis[1];
-    rotation[1][2] = temp[2] * axis[1] - s * axis[0];
-    rotation[2][2] = c + temp[2] * axis[2];
+        axis.Normalize();
+        Vector<3, T> temp = axis * (T(1) - c);
 
-    return *this = *this * rotation;
+        Matrix rotation = Identity();
+        rotation.At(0, 0) = c + temp[0] * axis[0];
+        rotation.At(0, 1) = temp[0] * axis[1] + s * axis[2];
+        rotation.At(0, 2) = temp[0] * axis[2] - s * axis[1];
+
+        rotation.At(1, 0) = temp[1] * axis[0] - s * axis[2];
+        rotation.At(1, 1) = c + temp[1] * axis[1];
+        rotation.At(1, 2) = temp[1] * axis[2] + s * axis[0];
+
+        rotation.At(2, 0) = temp[2] * axis[0] + s * axis[1];
+        rotation.At(2, 1) = temp[2] * axis[1] - s * axis[0];
+        rotation.At(2, 2) = c + temp[2] * axis[2];
+
+        return *this = *this * rotation;
+    } else {
+        throw DimensionsException<Width>("Matrix", "Rotate");
+    }
 }
 
-template <>
-inline Matrix<4>& Matrix<4>::Scale(const Vector<3>& dimensions) {
-    Matrix scale = Identity();
-    scale[0][0] = dimensions.X();
-    scale[1][1] = dimensions.Y();
-    scale[2][2] = dimensions.Z();
-    return *this = *this * scale;
+template <size_t Width, typename T>
+Matrix<Width, T>& Matrix<Width, T>::Scale(const Vector<Width - 1, T>& dimensions) {
+    if constexpr (Width == 4) {
+        Matrix scale = Identity();
+        scale.At(0, 0) = dimensions.X();
+        scale.At(1, 1) = dimensions.Y();
+        scale.At(2, 2) = dimensions.Z();
+        return *this = *this * scale;
+    } else {
+        throw DimensionsException<Width>("Matrix", "Scale");
+    }
 }
-} // namespace Geometry
\ No newline at end of file
+} // namespace Geometry
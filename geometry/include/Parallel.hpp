@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace Geometry {
+namespace Parallel {
+
+// Calls kernel(begin, end) on up to threadCount contiguous chunks of [0, count), the calling thread takes
+// the first one. Chunks are never smaller than minimumChunk, short ranges run on the calling thread only.
+// A threadCount of 0 uses every hardware thread.
+template <typename Kernel>
+void For(size_t count, unsigned threadCount, Kernel kernel, size_t minimumChunk = 1024) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    const auto chunks = std::max<size_t>(1, std::min<size_t>(threadCount, count / minimumChunk));
+    if (chunks == 1) {
+        kernel(size_t(0), count);
+        return;
+    }
+
+    const auto chunkSize = (count + chunks - 1) / chunks;
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+        threads.emplace_back(kernel, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+    kernel(size_t(0), chunkSize);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+} // namespace Parallel
+} // namespace Geometry
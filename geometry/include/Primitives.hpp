@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "Angle.hpp"
+#include "Trigonometry.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+
+// Shapes shared by broad and narrow phase collision code. Size is 2 for the XZ ground plane, where
+// Vector<2> holds { x, z } like Vector<3>::To2, or 3 for world space.
+
+template <size_t Size>
+struct Ray {
+    Vector<Size> origin;
+    // Not required to be unit length, ray casts return distances in multiples of it
+    Vector<Size> direction;
+
+    Vector<Size> At(float t) const { return origin + direction * t; }
+};
+
+template <size_t Size>
+struct Sphere {
+    Vector<Size> center;
+    float radius;
+
+    bool Contains(const Vector<Size>& point) const {
+        return Vector<Size>::DistanceSquared(point, center) <= radius * radius;
+    }
+
+    Vector<Size> ClosestPoint(const Vector<Size>& point) const {
+        const auto offset = point - center;
+        const auto squared = offset.MagnitudeSquared();
+        if (squared <= radius * radius)
+            return point;
+        return center + offset * (radius / std::sqrt(squared));
+    }
+};
+
+template <size_t Size>
+struct AABB {
+    Vector<Size> min;
+    Vector<Size> max;
+
+    static AABB Around(const Sphere<Size>& sphere) {
+        return { sphere.center - sphere.radius, sphere.center + sphere.radius };
+    }
+
+    static AABB Merged(const AABB& lhs, const AABB& rhs) {
+        return { Vector<Size>::Min(lhs.min, rhs.min), Vector<Size>::Max(lhs.max, rhs.max) };
+    }
+
+    Vector<Size> Center() const { return (min + max) * 0.5f; }
+    Vector<Size> Extents() const { return (max - min) * 0.5f; }
+
+    AABB Expanded(float margin) const { return { min - margin, max + margin }; }
+
+    bool Contains(const Vector<Size>& point) const {
+        for (size_t i = 0; i < Size; ++i)
+            if (point[i] < min[i] || point[i] > max[i])
+                return false;
+        return true;
+    }
+
+    bool Contains(const AABB& other) const {
+        for (size_t i = 0; i < Size; ++i)
+            if (other.min[i] < min[i] || other.max[i] > max[i])
+                return false;
+        return true;
+    }
+
+    Vector<Size> ClosestPoint(const Vector<Size>& point) const {
+        return Vector<Size>::Min(Vector<Size>::Max(point, min), max);
+    }
+};
+
+// Ring sector in the XZ plane, points between the two radii whose polar angle lies in the interval.
+// The wall directions are kept so containment never needs an arctangent.
+class AnnularSector {
+    float inner;
+    float outer;
+    AngleInterval angles;
+    Vector<2> fromDirection;
+    Vector<2> toDirection;
+
+    static float Cross(const Vector<2>& lhs, const Vector<2>& rhs) {
+        return lhs[0] * rhs[1] - lhs[1] * rhs[0];
+    }
+
+    static Vector<2> Direction(Angle angle) {
+        const auto sineCosine = angle.SinCos();
+        return { sineCosine.cosine, sineCosine.sine };
+    }
+
+    // Closest point of the wall from inner * direction to outer * direction
+    Vector<2> ClosestOnWall(const Vector<2>& point, const Vector<2>& direction) const {
+        return direction * std::clamp(Vector<2>::Dot(point, direction), inner, outer);
+    }
+
+public:
+    AnnularSector(float inner, float outer, const AngleInterval& angles)
+        : inner(inner),
+          outer(outer),
+          angles(angles),
+          fromDirection(Direction(angles.From())),
+          toDirection(Direction(angles.To())) {}
+
+    float InnerRadius() const { return inner; }
+    float OuterRadius() const { return outer; }
+    const AngleInterval& Angles() const { return angles; }
+    // Unit vectors along the walls at Angles().From() and Angles().To()
+    const Vector<2>& FromDirection() const { return fromDirection; }
+    const Vector<2>& ToDirection() const { return toDirection; }
+
+    // Whether the polar angle of point lies in Angles(), from the signs of two cross products
+    bool ContainsDirection(const Vector<2>& point) const {
+        const auto afterFrom = Cross(fromDirection, point) >= 0.f;
+        const auto beforeTo = Cross(point, toDirection) >= 0.f;
+        return angles.Width() <= pi ? afterFrom && beforeTo : afterFrom || beforeTo;
+    }
+
+    bool Contains(const Vector<2>& point) const {
+        const auto squared = point.MagnitudeSquared();
+        return squared >= inner * inner && squared <= outer * outer && ContainsDirection(point);
+    }
+
+    Vector<2> ClosestPoint(const Vector<2>& point) const {
+        if (ContainsDirection(point)) {
+            const auto magnitude = point.Magnitude();
+            if (magnitude == 0.f)
+                return Direction(angles.Middle()) * inner;
+            return point * (std::clamp(magnitude, inner, outer) / magnitude);
+        }
+
+        // Outside the cone the nearest point is on one of the walls, arc ends included
+        const auto onFrom = ClosestOnWall(point, fromDirection);
+        const auto onTo = ClosestOnWall(point, toDirection);
+        return Vector<2>::DistanceSquared(point, onFrom) <= Vector<2>::DistanceSquared(point, onTo) ? onFrom : onTo;
+    }
+
+    AABB<2> Bounds() const {
+        AABB<2> ret{ fromDirection * inner, fromDirection * inner };
+        const Vector<2> corners[] = { fromDirection * outer, toDirection * inner, toDirection * outer };
+        for (const auto& corner : corners)
+            ret = AABB<2>::Merged(ret, { corner, corner });
+        // The outer arc bulges past its ends wherever it crosses an axis
+        const Vector<2> axes[] = { { 1.f, 0.f }, { 0.f, 1.f }, { -1.f, 0.f }, { 0.f, -1.f } };
+        for (const auto& axis : axes)
+            if (ContainsDirection(axis))
+                ret = AABB<2>::Merged(ret, { axis * outer, axis * outer });
+        return ret;
+    }
+};
+
+// Overlap tests, touching shapes don't overlap
+template <size_t Size>
+bool Overlaps(const Sphere<Size>& lhs, const Sphere<Size>& rhs) {
+    const auto radii = lhs.radius + rhs.radius;
+    return Vector<Size>::DistanceSquared(lhs.center, rhs.center) < radii * radii;
+}
+
+template <size_t Size>
+bool Overlaps(const AABB<Size>& lhs, const AABB<Size>& rhs) {
+    for (size_t i = 0; i < Size; ++i)
+        if (lhs.max[i] <= rhs.min[i] || rhs.max[i] <= lhs.min[i])
+            return false;
+    return true;
+}
+
+template <size_t Size>
+bool Overlaps(const Sphere<Size>& sphere, const AABB<Size>& box) {
+    return Vector<Size>::DistanceSquared(sphere.center, box.ClosestPoint(sphere.center)) < sphere.radius * sphere.radius;
+}
+
+inline bool Overlaps(const Sphere<2>& sphere, const AnnularSector& sector) {
+    // Most spheres are far from the ring, reject them before touching the walls
+    const auto squared = sphere.center.MagnitudeSquared();
+    const auto outer = sector.OuterRadius() + sphere.radius;
+    const auto inner = sector.InnerRadius() - sphere.radius;
+    if (squared >= outer * outer || (inner > 0.f && squared <= inner * inner))
+        return false;
+    return Vector<2>::DistanceSquared(sphere.center, sector.ClosestPoint(sphere.center)) < sphere.radius * sphere.radius;
+}
+
+// Ray casts return the smallest t >= 0 at which ray.At(t) is inside the shape, 0 when the origin already is
+template <size_t Size>
+std::optional<float> RayCast(const Ray<Size>& ray, const Sphere<Size>& sphere) {
+    const auto offset = ray.origin - sphere.center;
+    const auto c = offset.MagnitudeSquared() - sphere.radius * sphere.radius;
+    if (c <= 0.f)
+        return 0.f;
+    const auto b = Vector<Size>::Dot(offset, ray.direction);
+    if (b >= 0.f)
+        return std::nullopt;
+    const auto a = ray.direction.MagnitudeSquared();
+    const auto discriminant = b * b - a * c;
+    if (discriminant < 0.f)
+        return std::nullopt;
+    return (-b - std::sqrt(discriminant)) / a;
+}
+
+// Slab test, a zero direction component makes its reciprocal infinite and the slab all or nothing
+template <size_t Size>
+std::optional<float> RayCast(const Ray<Size>& ray, const AABB<Size>& box) {
+    auto near = 0.f;
+    auto far = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < Size; ++i) {
+        if (ray.direction[i] == 0.f) {
+            if (ray.origin[i] < box.min[i] || ray.origin[i] > box.max[i])
+                return std::nullopt;
+            continue;
+        }
+        const auto reciprocal = 1.f / ray.direction[i];
+        auto t0 = (box.min[i] - ray.origin[i]) * reciprocal;
+        auto t1 = (box.max[i] - ray.origin[i]) * reciprocal;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        near = std::max(near, t0);
+        far = std::min(far, t1);
+        if (near > far)
+            return std::nullopt;
+    }
+    return near;
+}
+
+inline std::optional<float> RayCast(const Ray<2>& ray, const AnnularSector& sector) {
+    if (sector.Contains(ray.origin))
+        return 0.f;
+
+    std::optional<float> ret;
+    const auto consider = [&](float t) {
+        if (t >= 0.f && (!ret || t < *ret) && sector.ContainsDirection(ray.At(t)))
+            ret = t;
+    };
+
+    // Entering through the outer arc is the first root, through the inner arc the second
+    const auto a = ray.direction.MagnitudeSquared();
+    const auto b = Vector<2>::Dot(ray.origin, ray.direction);
+    const auto squared = ray.origin.MagnitudeSquared();
+    const auto considerArc = [&](float radius, float sign) {
+        const auto discriminant = b * b - a * (squared - radius * radius);
+        if (discriminant >= 0.f)
+            consider((-b + sign * std::sqrt(discriminant)) / a);
+    };
+    considerArc(sector.OuterRadius(), -1.f);
+    considerArc(sector.InnerRadius(), 1.f);
+
+    // Walls are the segments from InnerRadius to OuterRadius along either wall direction
+    for (const auto& direction : { sector.FromDirection(), sector.ToDirection() }) {
+        const auto denominator = direction[0] * ray.direction[1] - direction[1] * ray.direction[0];
+        if (denominator == 0.f)
+            continue;
+        const auto t = -(direction[0] * ray.origin[1] - direction[1] * ray.origin[0]) / denominator;
+        const auto along = Vector<2>::Dot(ray.At(t), direction);
+        if (t >= 0.f && along >= sector.InnerRadius() && along <= sector.OuterRadius() && (!ret || t < *ret))
+            ret = t;
+    }
+    return ret;
+}
+
+// First contact of a moving shape, t in multiples of the motion and a unit normal pointing from the
+// touched surface towards the center of the moving shape
+template <size_t Size>
+struct SweepHit {
+    float t;
+    Vector<Size> normal;
+};
+
+// First contact of two spheres moving by their motions for t in [0, 1], the normal points from rhs to lhs.
+// The center of lhs is cast along the relative motion against a sphere of both radii around rhs. Spheres
+// already overlapping at the start, or only grazing, have no contact to report.
+template <size_t Size>
+std::optional<SweepHit<Size>> Sweep(const Sphere<Size>& lhs, const Vector<Size>& lhsMotion, const Sphere<Size>& rhs, const Vector<Size>& rhsMotion) {
+    if (Overlaps(lhs, rhs))
+        return std::nullopt;
+    const Ray<Size> relative{ lhs.center, lhsMotion - rhsMotion };
+    const auto radii = lhs.radius + rhs.radius;
+    const auto t = RayCast(relative, Sphere<Size>{ rhs.center, radii });
+    if (!t || *t > 1.f)
+        return std::nullopt;
+    const auto normal = (relative.At(*t) - rhs.center) * (1.f / radii);
+    if (Vector<Size>::Dot(relative.direction, normal) >= 0.f)
+        return std::nullopt;
+    return SweepHit<Size>{ *t, normal };
+}
+
+// First contact of the sphere moving by motion with the sector for t in [0, 1]. The center is cast against
+// the sector grown by the radius: both arcs offset by it, both walls pushed out by it and circles around
+// the four corners, so the cost is the same for every contact. A sphere already overlapping the sector at
+// the start, or only grazing it, has no contact to report.
+inline std::optional<SweepHit<2>> Sweep(const Sphere<2>& sphere, const Vector<2>& motion, const AnnularSector& sector) {
+    const auto a = motion.MagnitudeSquared();
+    if (a == 0.f || Overlaps(sphere, sector))
+        return std::nullopt;
+
+    const Ray<2> ray{ sphere.center, motion };
+    std::optional<SweepHit<2>> ret;
+    // Only contacts within the motion and before the best one so far are worth checking further
+    const auto earlier = [&](float t) { return t >= 0.f && t <= 1.f && (!ret || t < ret->t); };
+    const auto consider = [&](float t, const Vector<2>& normal) {
+        if (Vector<2>::Dot(motion, normal) < 0.f)
+            ret = SweepHit<2>{ t, normal };
+    };
+
+    // The outer arc is reached entering its circle, the inner one leaving its circle, both only within the
+    // angles of the sector
+    const auto b = Vector<2>::Dot(sphere.center, motion);
+    const auto squared = sphere.center.MagnitudeSquared();
+    const auto considerArc = [&](float radius, float sign) {
+        if (radius <= 0.f)
+            return;
+        const auto discriminant = b * b - a * (squared - radius * radius);
+        if (discriminant < 0.f)
+            return;
+        const auto t = (-b + sign * std::sqrt(discriminant)) / a;
+        if (!earlier(t))
+            return;
+        const auto center = ray.At(t);
+        if (sector.ContainsDirection(center))
+            consider(t, center * (-sign / radius));
+    };
+    considerArc(sector.OuterRadius() + sphere.radius, -1.f);
+    considerArc(sector.InnerRadius() - sphere.radius, 1.f);
+
+    // The sector lies counterclockwise of the wall at From and clockwise of the one at To, the normals point
+    // away from it. The contact has to land on the wall between both radii.
+    const auto considerWall = [&](const Vector<2>& direction, const Vector<2>& normal) {
+        const auto approach = Vector<2>::Dot(motion, normal);
+        if (approach >= 0.f)
+            return;
+        const auto t = (sphere.radius - Vector<2>::Dot(sphere.center, normal)) / approach;
+        if (!earlier(t))
+            return;
+        const auto along = Vector<2>::Dot(ray.At(t), direction);
+        if (along >= sector.InnerRadius() && along <= sector.OuterRadius())
+            consider(t, normal);
+    };
+    const auto& from = sector.FromDirection();
+    const auto& to = sector.ToDirection();
+    considerWall(from, { from[1], -from[0] });
+    considerWall(to, { -to[1], to[0] });
+
+    for (const auto& direction : { from, to }) {
+        for (const auto radius : { sector.InnerRadius(), sector.OuterRadius() }) {
+            const auto corner = direction * radius;
+            const auto t = RayCast(ray, Sphere<2>{ corner, sphere.radius });
+            if (t && earlier(*t))
+                consider(*t, (ray.At(*t) - corner) * (1.f / sphere.radius));
+        }
+    }
+    return ret;
+}
+
+} // namespace Geometry
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <ostream>
+
+#include "Matrix.hpp"
+#include "Trigonometry.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+
+class Quaternion {
+    float w;
+    Vector<3> imaginary;
+
+public:
+    Quaternion()
+        : Quaternion(1.f, 0.f, 0.f, 0.f) {}
+
+    Quaternion(float w, float x, float y, float z)
+        : w(w), imaginary{ x, y, z } {}
+
+    Quaternion(float w, const Vector<3>& imaginary)
+        : w(w), imaginary(imaginary) {}
+
+    float W() const { return w; }
+    float X() const { return imaginary.X(); }
+    float Y() const { return imaginary.Y(); }
+    float Z() const { return imaginary.Z(); }
+    const Vector<3>& Imaginary() const { return imaginary; }
+
+    float Magnitude() const {
+        return std::sqrt(Dot(*this, *this));
+    }
+
+    Quaternion& Normalize() {
+        const auto mag = Magnitude();
+        if (mag == 0)
+            return *this;
+        w /= mag;
+        imaginary /= Vector<3>(mag);
+        return *this;
+    }
+
+    Quaternion& Conjugate() {
+        imaginary.Invert();
+        return *this;
+    }
+
+    Vector<3> Rotate(const Vector<3>& vec) const {
+        // v + 2w(q x v) + 2q x (q x v), valid for unit quaternions
+        const auto t = Vector<3>::Cross(imaginary, vec) * 2.f;
+        return vec + t * w + Vector<3>::Cross(imaginary, t);
+    }
+
+    Matrix<4> ToMatrix() const;
+
+    // Bool operators
+    friend bool operator==(const Quaternion& lhs, const Quaternion& rhs) { return lhs.w == rhs.w && lhs.imaginary == rhs.imaginary; }
+    friend bool operator!=(const Quaternion& lhs, const Quaternion& rhs) { return !(lhs == rhs); }
+    // Composition, rhs is applied first
+    friend Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs) {
+        return { lhs.w * rhs.w - Vector<3>::Dot(lhs.imaginary, rhs.imaginary),
+                 rhs.imaginary * lhs.w + lhs.imaginary * rhs.w + Vector<3>::Cross(lhs.imaginary, rhs.imaginary) };
+    }
+
+    // Output stream operator
+    friend std::ostream& operator<<(std::ostream& os, const Quaternion& quat) {
+        return os << "(" << quat.w << ", " << quat.imaginary << ")";
+    }
+
+    // Static methods
+    static Quaternion FromAxisAngle(float angle, Vector<3> axis) {
+        axis.Normalize();
+        return { std::cos(angle / 2.f), axis * std::sin(angle / 2.f) };
+    }
+
+    static Quaternion Normalized(Quaternion quat) {
+        return quat.Normalize();
+    }
+
+    static Quaternion Conjugated(Quaternion quat) {
+        return quat.Conjugate();
+    }
+
+    static float Dot(const Quaternion& lhs, const Quaternion& rhs) {
+        return lhs.w * rhs.w + Vector<3>::Dot(lhs.imaginary, rhs.imaginary);
+    }
+
+    static Quaternion Slerp(const Quaternion& from, Quaternion to, float t) {
+        auto cosine = Dot(from, to);
+        // Take the shorter arc
+        if (cosine < 0.f) {
+            to = { -to.w, Vector<3>::Inverted(to.imaginary) };
+            cosine = -cosine;
+        }
+
+        float fromWeight = 1.f - t;
+        float toWeight = t;
+        // Nearly parallel quaternions fall back to linear interpolation
+        if (cosine < 0.9995f) {
+            const auto angle = std::acos(cosine);
+            const auto sine = std::sin(angle);
+            fromWeight = std::sin(fromWeight * angle) / sine;
+            toWeight = std::sin(toWeight * angle) / sine;
+        }
+
+        return Normalized({ from.w * fromWeight + to.w * toWeight, from.imaginary * fromWeight + to.imaginary * toWeight });
+    }
+};
+
+// Rotation with its sine, cosine and basis computed once, so applying it repeatedly needs no trigonometry
+class Rotation {
+    float angle;
+    Vector<3> axis;
+    float sine;
+    float cosine;
+    // Images of the X, Y and Z unit vectors
+    std::array<Vector<3>, 3> columns;
+
+    Rotation(float angle, const Vector<3>& axis, float sine, float cosine)
+        : angle(angle), axis(axis), sine(sine), cosine(cosine) {
+        const auto temp = axis * (1.f - cosine);
+        columns[0] = { cosine + temp[0] * axis[0], temp[0] * axis[1] + sine * axis[2], temp[0] * axis[2] - sine * axis[1] };
+        columns[1] = { temp[1] * axis[0] - sine * axis[2], cosine + temp[1] * axis[1], temp[1] * axis[2] + sine * axis[0] };
+        columns[2] = { temp[2] * axis[0] + sine * axis[1], temp[2] * axis[1] - sine * axis[0], cosine + temp[2] * axis[2] };
+    }
+
+public:
+    Rotation()
+        : Rotation(0.f, { 0.f, 1.f, 0.f }, 0.f, 1.f) {}
+
+    Rotation(float angle, const Vector<3>& axis)
+        : Rotation(angle, Vector<3>::Normalized(axis), std::sin(angle), std::cos(angle)) {}
+
+    explicit Rotation(const Quaternion& quat)
+        : Rotation() {
+        const auto unit = Quaternion::Normalized(quat);
+        const auto halfSine = unit.Imaginary().Magnitude();
+        if (halfSine == 0.f)
+            return;
+        *this = Rotation(2.f * std::atan2(halfSine, unit.W()), unit.Imaginary() / halfSine);
+    }
+
+    float Angle() const { return angle; }
+    const Vector<3>& Axis() const { return axis; }
+    float Sin() const { return sine; }
+    float Cos() const { return cosine; }
+
+    Vector<3> Apply(const Vector<3>& vec) const {
+        return columns[0] * vec.X() + columns[1] * vec.Y() + columns[2] * vec.Z();
+    }
+
+    Rotation& Invert() {
+        return *this = Rotation(-angle, axis, -sine, cosine);
+    }
+
+    Quaternion ToQuaternion() const {
+        return Quaternion::FromAxisAngle(angle, axis);
+    }
+
+    // Same matrix as Matrix<4>::Identity().Rotate(Angle(), Axis())
+    Matrix<4> ToMatrix() const {
+        auto ret = Matrix<4>::Identity();
+        for (size_t i = 0; i < 3; ++i)
+            for (size_t j = 0; j < 3; ++j)
+                ret[i][j] = columns[j][i];
+        return ret;
+    }
+
+    // Composition, rhs is applied first
+    friend Rotation operator*(const Rotation& lhs, const Rotation& rhs) {
+        return Rotation(lhs.ToQuaternion() * rhs.ToQuaternion());
+    }
+
+    // Static methods
+    static Rotation AroundY(float angle) {
+        return AroundY(angle, { std::sin(angle), std::cos(angle) });
+    }
+
+    // For callers that already hold the sine and cosine of angle, e.g. from SinCos or an AngleTable
+    static Rotation AroundY(float angle, const SineCosine& sineCosine) {
+        return Rotation(angle, { 0.f, 1.f, 0.f }, sineCosine.sine, sineCosine.cosine);
+    }
+
+    static Rotation Inverted(Rotation rotation) {
+        return rotation.Invert();
+    }
+};
+
+inline Matrix<4> Quaternion::ToMatrix() const {
+    return Rotation(*this).ToMatrix();
+}
+
+template <size_t Size, typename T>
+Vector<Size, T>& Vector<Size, T>::Rotate(const Rotation& rotation) {
+    static_assert(std::is_same_v<T, float>, "Rotation only supports float vectors.");
+    if constexpr (Size == 3) {
+        return *this = rotation.Apply(*this);
+    } else {
+        const auto rotated = rotation.Apply({ data[0], data[1], data[2] });
+        data[0] = rotated.X();
+        data[1] = rotated.Y();
+        data[2] = rotated.Z();
+        return *this;
+    }
+}
+
+template <>
+inline Matrix<4>& Matrix<4>::Rotate(const Rotation& rotation) {
+    return *this = *this * rotation.ToMatrix();
+}
+
+} // namespace Geometry
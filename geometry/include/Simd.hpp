@@ -0,0 +1,260 @@
+#pragma once
+
+// SIMD backend is chosen at compile time. Define GEOMETRY_NO_SIMD to force the scalar fallback.
+// Define GEOMETRY_FAST_MATH to trade the last bits of ReciprocalSqrt, and everything normalized through
+// it, for the hardware estimate.
+// Debug builds assert that everything passed to Load and Store is 16 byte aligned, define NDEBUG to drop
+// the checks.
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(GEOMETRY_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GEOMETRY_SIMD 1
+#include <emmintrin.h>
+#else
+#define GEOMETRY_SIMD 0
+#include <utility>
+#endif
+
+namespace Geometry {
+namespace Simd {
+
+// Alignment Load and Store expect
+constexpr size_t alignment = 16;
+
+inline bool IsAligned(const void* ptr, size_t boundary = alignment) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % boundary == 0;
+}
+
+// Four float lanes, loaded from and stored to 16 byte aligned memory
+#if GEOMETRY_SIMD
+using Float4 = __m128;
+
+inline Float4 Load(const float* ptr) {
+    assert(IsAligned(ptr) && "Misaligned SIMD load");
+    return _mm_load_ps(ptr);
+}
+inline void Store(float* ptr, Float4 value) {
+    assert(IsAligned(ptr) && "Misaligned SIMD store");
+    _mm_store_ps(ptr, value);
+}
+inline Float4 LoadUnaligned(const float* ptr) { return _mm_loadu_ps(ptr); }
+inline void StoreUnaligned(float* ptr, Float4 value) { _mm_storeu_ps(ptr, value); }
+inline Float4 Splat(float value) { return _mm_set1_ps(value); }
+
+inline Float4 Add(Float4 lhs, Float4 rhs) { return _mm_add_ps(lhs, rhs); }
+inline Float4 Sub(Float4 lhs, Float4 rhs) { return _mm_sub_ps(lhs, rhs); }
+inline Float4 Mul(Float4 lhs, Float4 rhs) { return _mm_mul_ps(lhs, rhs); }
+inline Float4 Div(Float4 lhs, Float4 rhs) { return _mm_div_ps(lhs, rhs); }
+inline Float4 Sqrt(Float4 value) { return _mm_sqrt_ps(value); }
+inline Float4 Negate(Float4 value) { return _mm_xor_ps(value, _mm_set1_ps(-0.f)); }
+inline Float4 Abs(Float4 value) { return _mm_andnot_ps(_mm_set1_ps(-0.f), value); }
+inline Float4 Min(Float4 lhs, Float4 rhs) { return _mm_min_ps(lhs, rhs); }
+inline Float4 Max(Float4 lhs, Float4 rhs) { return _mm_max_ps(lhs, rhs); }
+
+// 1 / sqrt(value), under GEOMETRY_FAST_MATH the estimate gets one Newton-Raphson step for about 22 bits.
+// The scalar and the four lane versions round the same way.
+#ifdef GEOMETRY_FAST_MATH
+inline Float4 ReciprocalSqrt(Float4 value) {
+    const auto estimate = _mm_rsqrt_ps(value);
+    const auto half = _mm_mul_ps(_mm_set1_ps(0.5f), value);
+    return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, _mm_mul_ps(estimate, estimate))));
+}
+
+inline float ReciprocalSqrt(float value) {
+    return _mm_cvtss_f32(ReciprocalSqrt(_mm_set_ss(value)));
+}
+#else
+inline Float4 ReciprocalSqrt(Float4 value) { return _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(value)); }
+inline float ReciprocalSqrt(float value) { return 1.f / std::sqrt(value); }
+#endif
+
+// Lane masks, only meant to be passed to Select
+inline Float4 Greater(Float4 lhs, Float4 rhs) { return _mm_cmpgt_ps(lhs, rhs); }
+inline Float4 Less(Float4 lhs, Float4 rhs) { return _mm_cmplt_ps(lhs, rhs); }
+inline Float4 Equal(Float4 lhs, Float4 rhs) { return _mm_cmpeq_ps(lhs, rhs); }
+inline Float4 Select(Float4 mask, Float4 ifTrue, Float4 ifFalse) { return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse)); }
+
+// Four int lanes, enough for the quadrant bookkeeping of the trigonometry kernels
+using Int4 = __m128i;
+
+// Truncates toward zero like static_cast<int>
+inline Int4 ToInt(Float4 value) { return _mm_cvttps_epi32(value); }
+inline Float4 ToFloat(Int4 value) { return _mm_cvtepi32_ps(value); }
+inline Int4 AddInt(Int4 value, int scalar) { return _mm_add_epi32(value, _mm_set1_epi32(scalar)); }
+// Mask of the lanes where value & bit is non zero
+inline Float4 TestBit(Int4 value, int bit) {
+    const auto mask = _mm_set1_epi32(bit);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(value, mask), mask));
+}
+
+// Horizontal sums keep the ((x + y) + z) + w order of a scalar loop so results are bit identical
+inline float Sum3(Float4 value) {
+    const auto y = _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1));
+    const auto z = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(value, y), z));
+}
+
+inline float Sum4(Float4 value) {
+    const auto w = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+    return Sum3(value) + _mm_cvtss_f32(w);
+}
+
+inline Float4 Cross(Float4 lhs, Float4 rhs) {
+    const auto lhsYzx = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+    const auto lhsZxy = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 1, 0, 2));
+    const auto rhsYzx = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+    const auto rhsZxy = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm_sub_ps(_mm_mul_ps(lhsYzx, rhsZxy), _mm_mul_ps(rhsYzx, lhsZxy));
+}
+
+// Transposes the 4x4 matrix whose rows are the four registers
+inline void Transpose(Float4& row0, Float4& row1, Float4& row2, Float4& row3) {
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+}
+#else
+struct Float4 {
+    float lanes[4];
+};
+
+// Checked like the SIMD backend, so storage that would fault there is caught by scalar builds too
+inline Float4 Load(const float* ptr) {
+    assert(IsAligned(ptr) && "Misaligned SIMD load");
+    return { { ptr[0], ptr[1], ptr[2], ptr[3] } };
+}
+inline void Store(float* ptr, Float4 value) {
+    assert(IsAligned(ptr) && "Misaligned SIMD store");
+    for (unsigned i = 0; i < 4; ++i)
+        ptr[i] = value.lanes[i];
+}
+inline Float4 LoadUnaligned(const float* ptr) { return { { ptr[0], ptr[1], ptr[2], ptr[3] } }; }
+inline void StoreUnaligned(float* ptr, Float4 value) {
+    for (unsigned i = 0; i < 4; ++i)
+        ptr[i] = value.lanes[i];
+}
+inline Float4 Splat(float value) { return { { value, value, value, value } }; }
+
+inline Float4 Add(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] += rhs.lanes[i];
+    return lhs;
+}
+
+inline Float4 Sub(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] -= rhs.lanes[i];
+    return lhs;
+}
+
+inline Float4 Mul(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] *= rhs.lanes[i];
+    return lhs;
+}
+
+inline Float4 Div(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] /= rhs.lanes[i];
+    return lhs;
+}
+
+inline Float4 Sqrt(Float4 value) {
+    for (unsigned i = 0; i < 4; ++i)
+        value.lanes[i] = std::sqrt(value.lanes[i]);
+    return value;
+}
+
+inline Float4 Negate(Float4 value) {
+    for (unsigned i = 0; i < 4; ++i)
+        value.lanes[i] = -value.lanes[i];
+    return value;
+}
+
+inline Float4 Abs(Float4 value) {
+    for (unsigned i = 0; i < 4; ++i)
+        value.lanes[i] = std::abs(value.lanes[i]);
+    return value;
+}
+
+// Same operand order as minps and maxps, the second operand wins ties and NaNs
+inline Float4 Min(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] = lhs.lanes[i] < rhs.lanes[i] ? lhs.lanes[i] : rhs.lanes[i];
+    return lhs;
+}
+
+inline Float4 Max(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] = lhs.lanes[i] > rhs.lanes[i] ? lhs.lanes[i] : rhs.lanes[i];
+    return lhs;
+}
+
+inline Float4 ReciprocalSqrt(Float4 value) {
+    for (unsigned i = 0; i < 4; ++i)
+        value.lanes[i] = 1.f / std::sqrt(value.lanes[i]);
+    return value;
+}
+
+inline float ReciprocalSqrt(float value) { return 1.f / std::sqrt(value); }
+
+inline Float4 Greater(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] = lhs.lanes[i] > rhs.lanes[i] ? 1.f : 0.f;
+    return lhs;
+}
+
+inline Float4 Less(Float4 lhs, Float4 rhs) { return Greater(rhs, lhs); }
+
+inline Float4 Equal(Float4 lhs, Float4 rhs) {
+    for (unsigned i = 0; i < 4; ++i)
+        lhs.lanes[i] = lhs.lanes[i] == rhs.lanes[i] ? 1.f : 0.f;
+    return lhs;
+}
+
+inline Float4 Select(Float4 mask, Float4 ifTrue, Float4 ifFalse) {
+    for (unsigned i = 0; i < 4; ++i)
+        ifFalse.lanes[i] = mask.lanes[i] != 0.f ? ifTrue.lanes[i] : ifFalse.lanes[i];
+    return ifFalse;
+}
+
+struct Int4 {
+    int lanes[4];
+};
+
+inline Int4 ToInt(Float4 value) { return { { static_cast<int>(value.lanes[0]), static_cast<int>(value.lanes[1]), static_cast<int>(value.lanes[2]), static_cast<int>(value.lanes[3]) } }; }
+inline Float4 ToFloat(Int4 value) { return { { static_cast<float>(value.lanes[0]), static_cast<float>(value.lanes[1]), static_cast<float>(value.lanes[2]), static_cast<float>(value.lanes[3]) } }; }
+
+inline Int4 AddInt(Int4 value, int scalar) {
+    for (unsigned i = 0; i < 4; ++i)
+        value.lanes[i] += scalar;
+    return value;
+}
+
+inline Float4 TestBit(Int4 value, int bit) {
+    Float4 ret;
+    for (unsigned i = 0; i < 4; ++i)
+        ret.lanes[i] = value.lanes[i] & bit ? 1.f : 0.f;
+    return ret;
+}
+
+inline float Sum3(Float4 value) { return value.lanes[0] + value.lanes[1] + value.lanes[2]; }
+inline float Sum4(Float4 value) { return value.lanes[0] + value.lanes[1] + value.lanes[2] + value.lanes[3]; }
+
+inline Float4 Cross(Float4 lhs, Float4 rhs) {
+    const auto& l = lhs.lanes;
+    const auto& r = rhs.lanes;
+    return { { l[1] * r[2] - r[1] * l[2], l[2] * r[0] - r[2] * l[0], l[0] * r[1] - r[0] * l[1], 0.f } };
+}
+
+inline void Transpose(Float4& row0, Float4& row1, Float4& row2, Float4& row3) {
+    Float4* rows[] = { &row0, &row1, &row2, &row3 };
+    for (unsigned j = 1; j < 4; ++j)
+        for (unsigned i = 0; i < j; ++i)
+            std::swap(rows[i]->lanes[j], rows[j]->lanes[i]);
+}
+#endif
+
+} // namespace Simd
+} // namespace Geometry
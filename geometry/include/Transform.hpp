@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <ostream>
+
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+
+// Affine transform with the same memory layout and composition order as Matrix<4>.
+// Only the 3x4 affine part is ever computed, the constant { 0, 0, 0, 1 } column is kept
+// in storage so the data can be handed to glUniformMatrix4fv without conversion.
+class Transform3 {
+    // Rows 0-2 hold the images of the basis vectors, row 3 holds the translation
+    alignas(16) std::array<float, 16> data;
+
+    float& At(size_t row, size_t column) { return data[4 * row + column]; }
+    float At(size_t row, size_t column) const { return data[4 * row + column]; }
+
+public:
+    Transform3()
+        : data{ 1.f, 0.f, 0.f, 0.f,
+                0.f, 1.f, 0.f, 0.f,
+                0.f, 0.f, 1.f, 0.f,
+                0.f, 0.f, 0.f, 1.f } {}
+
+    Transform3& Translate(const Vector<3>& dimensions) {
+        At(3, 0) += dimensions.X();
+        At(3, 1) += dimensions.Y();
+        At(3, 2) += dimensions.Z();
+        return *this;
+    }
+
+    Transform3& RotateY(float angle) {
+        const auto c = std::cos(angle);
+        const auto s = std::sin(angle);
+        for (size_t row = 0; row < 4; ++row) {
+            const auto x = At(row, 0);
+            const auto z = At(row, 2);
+            At(row, 0) = c * x + s * z;
+            At(row, 2) = c * z - s * x;
+        }
+        return *this;
+    }
+
+    Transform3& Rotate(const Rotation& rotation) {
+        for (size_t row = 0; row < 4; ++row) {
+            const auto rotated = rotation.Apply({ At(row, 0), At(row, 1), At(row, 2) });
+            At(row, 0) = rotated.X();
+            At(row, 1) = rotated.Y();
+            At(row, 2) = rotated.Z();
+        }
+        return *this;
+    }
+
+    Transform3& Scale(const Vector<3>& dimensions) {
+        for (size_t row = 0; row < 4; ++row) {
+            At(row, 0) *= dimensions.X();
+            At(row, 1) *= dimensions.Y();
+            At(row, 2) *= dimensions.Z();
+        }
+        return *this;
+    }
+
+    // Transforms a point the same way the model matrix does in the shader
+    Vector<3> Apply(const Vector<3>& point) const {
+        Vector<3> ret;
+        for (size_t column = 0; column < 3; ++column)
+            ret[column] = point.X() * At(0, column) + point.Y() * At(1, column) + point.Z() * At(2, column) + At(3, column);
+        return ret;
+    }
+
+    Matrix<4> ToMatrix() const {
+        Matrix<4> ret;
+        for (size_t row = 0; row < 4; ++row)
+            for (size_t column = 0; column < 4; ++column)
+                ret[column][row] = At(row, column);
+        return ret;
+    }
+
+    // Dereference operator
+    const float* operator&() const { return &data[0]; }
+    // Bool operators
+    friend bool operator==(const Transform3& lhs, const Transform3& rhs) { return lhs.data == rhs.data; }
+    friend bool operator!=(const Transform3& lhs, const Transform3& rhs) { return lhs.data != rhs.data; }
+    // Composition in Matrix<4> order, lhs is applied first
+    friend Transform3 operator*(const Transform3& lhs, const Transform3& rhs) {
+        Transform3 out;
+        for (size_t row = 0; row < 4; ++row)
+            for (size_t column = 0; column < 3; ++column)
+                out.At(row, column) = lhs.At(row, 0) * rhs.At(0, column) + lhs.At(row, 1) * rhs.At(1, column) + lhs.At(row, 2) * rhs.At(2, column) + (row == 3 ? rhs.At(3, column) : 0.f);
+        return out;
+    }
+
+    // Output stream operator
+    friend std::ostream& operator<<(std::ostream& os, const Transform3& transform) {
+        return os << transform.ToMatrix();
+    }
+};
+
+} // namespace Geometry
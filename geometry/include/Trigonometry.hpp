@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "Simd.hpp"
+#include "Utility.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+
+// Runtime sine, cosine and arctangent built from minimax polynomials instead of libm calls.
+// Both are branch light, never touch errno and give the same results with and without SIMD.
+
+struct SineCosine {
+    float sine;
+    float cosine;
+};
+
+namespace Detail {
+// Minimax polynomials on [-pi / 4, pi / 4]
+inline float SinPolynomial(float x, float square) {
+    return ((-1.9515295891e-4f * square + 8.3321608736e-3f) * square - 1.6666654611e-1f) * square * x + x;
+}
+
+inline float CosPolynomial(float square) {
+    return ((2.443315711809948e-5f * square - 1.388731625493765e-3f) * square + 4.166664568298827e-2f) * square * square - 0.5f * square + 1.f;
+}
+
+// Minimax polynomial on [-tan(pi / 8), tan(pi / 8)]
+inline float AtanPolynomial(float x) {
+    const auto square = x * x;
+    return (((8.05374449538e-2f * square - 1.38776856032e-1f) * square + 1.99777106478e-1f) * square - 3.33329491539e-1f) * square * x + x;
+}
+
+// Four lane versions, every operation in the same order as above
+inline Simd::Float4 SinPolynomial(Simd::Float4 x, Simd::Float4 square) {
+    using namespace Simd;
+    auto ret = Add(Mul(Splat(-1.9515295891e-4f), square), Splat(8.3321608736e-3f));
+    ret = Sub(Mul(ret, square), Splat(1.6666654611e-1f));
+    return Add(Mul(Mul(ret, square), x), x);
+}
+
+inline Simd::Float4 CosPolynomial(Simd::Float4 square) {
+    using namespace Simd;
+    auto ret = Sub(Mul(Splat(2.443315711809948e-5f), square), Splat(1.388731625493765e-3f));
+    ret = Add(Mul(ret, square), Splat(4.166664568298827e-2f));
+    ret = Sub(Mul(Mul(ret, square), square), Mul(Splat(0.5f), square));
+    return Add(ret, Splat(1.f));
+}
+
+inline Simd::Float4 AtanPolynomial(Simd::Float4 x) {
+    using namespace Simd;
+    const auto square = Mul(x, x);
+    auto ret = Sub(Mul(Splat(8.05374449538e-2f), square), Splat(1.38776856032e-1f));
+    ret = Add(Mul(ret, square), Splat(1.99777106478e-1f));
+    ret = Sub(Mul(ret, square), Splat(3.33329491539e-1f));
+    return Add(Mul(Mul(ret, square), x), x);
+}
+} // namespace Detail
+
+// Absolute error of both results is below 1.2e-7 for |angle| <= 8192
+inline SineCosine SinCos(float angle) {
+    // Reduce to [-pi / 4, pi / 4] around the nearest multiple of pi / 2. The multiple is subtracted in
+    // three parts, the first two exact in float, so the reduction itself loses no precision.
+    const auto quadrant = static_cast<int>(angle * (2.f / pi) + (angle < 0.f ? -0.5f : 0.5f));
+    const auto multiple = static_cast<float>(quadrant);
+    const auto x = ((angle - multiple * 1.5703125f) - multiple * 4.837512969970703125e-4f) - multiple * 7.54978995489188216e-8f;
+    const auto square = x * x;
+    const auto sine = Detail::SinPolynomial(x, square);
+    const auto cosine = Detail::CosPolynomial(square);
+
+    // Odd quadrants swap sine and cosine, the signs follow the quadrant. Written as selects rather than
+    // a switch so the compiler can avoid branching on the quadrant.
+    SineCosine ret{ quadrant & 1 ? cosine : sine, quadrant & 1 ? sine : cosine };
+    if (quadrant & 2)
+        ret.sine = -ret.sine;
+    if ((quadrant + 1) & 2)
+        ret.cosine = -ret.cosine;
+    return ret;
+}
+
+// Sine and cosine of the sum of two angles
+inline SineCosine SinCosSum(const SineCosine& lhs, const SineCosine& rhs) {
+    return { lhs.sine * rhs.cosine + lhs.cosine * rhs.sine, lhs.cosine * rhs.cosine - lhs.sine * rhs.sine };
+}
+
+// Absolute error is below 3.5e-7, signed zeros and infinities aside it matches std::atan2
+inline float Atan2(float y, float x) {
+    if (x == 0.f)
+        return y > 0.f ? pi / 2 : y < 0.f ? -pi / 2 : 0.f;
+
+    // atan(t) for t >= 0 is reduced to [0, tan(pi / 8)] through atan(t) = pi / 2 - atan(1 / t)
+    // and atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+    const auto ratio = y / x;
+    auto t = std::abs(ratio);
+    auto offset = 0.f;
+    if (t > 2.414213562373095f) {
+        offset = pi / 2;
+        t = -1.f / t;
+    } else if (t > 0.4142135623730950f) {
+        offset = pi / 4;
+        t = (t - 1.f) / (t + 1.f);
+    }
+    auto ret = offset + Detail::AtanPolynomial(t);
+    if (ratio < 0.f)
+        ret = -ret;
+
+    if (x < 0.f)
+        ret += y < 0.f ? -pi : pi;
+    return ret;
+}
+
+// Span kernels, four values per iteration. Results are bit identical to the scalar functions above, so the
+// same error bounds hold. Outputs may alias inputs.
+
+inline void SinCos(const float* angles, size_t count, float* sines, float* cosines) {
+    using namespace Simd;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const auto angle = LoadUnaligned(angles + i);
+        const auto rounding = Select(Less(angle, Splat(0.f)), Splat(-0.5f), Splat(0.5f));
+        const auto quadrant = ToInt(Add(Mul(angle, Splat(2.f / pi)), rounding));
+        const auto multiple = ToFloat(quadrant);
+        auto x = Sub(angle, Mul(multiple, Splat(1.5703125f)));
+        x = Sub(x, Mul(multiple, Splat(4.837512969970703125e-4f)));
+        x = Sub(x, Mul(multiple, Splat(7.54978995489188216e-8f)));
+        const auto square = Mul(x, x);
+        const auto sine = Detail::SinPolynomial(x, square);
+        const auto cosine = Detail::CosPolynomial(square);
+
+        const auto odd = TestBit(quadrant, 1);
+        auto retSine = Select(odd, cosine, sine);
+        auto retCosine = Select(odd, sine, cosine);
+        retSine = Select(TestBit(quadrant, 2), Negate(retSine), retSine);
+        retCosine = Select(TestBit(AddInt(quadrant, 1), 2), Negate(retCosine), retCosine);
+        StoreUnaligned(sines + i, retSine);
+        StoreUnaligned(cosines + i, retCosine);
+    }
+    for (; i < count; ++i) {
+        const auto sineCosine = SinCos(angles[i]);
+        sines[i] = sineCosine.sine;
+        cosines[i] = sineCosine.cosine;
+    }
+}
+
+inline void Atan2(const float* y, const float* x, size_t count, float* out) {
+    using namespace Simd;
+    const auto zero = Splat(0.f);
+    const auto halfPi = Splat(pi / 2);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const auto yLanes = LoadUnaligned(y + i);
+        const auto xLanes = LoadUnaligned(x + i);
+        // Lanes with x == 0 divide by zero here and get replaced at the end
+        const auto ratio = Div(yLanes, xLanes);
+        const auto t = Abs(ratio);
+        const auto large = Greater(t, Splat(2.414213562373095f));
+        const auto medium = Greater(t, Splat(0.4142135623730950f));
+        const auto offset = Select(large, halfPi, Select(medium, Splat(pi / 4), zero));
+        const auto reduced = Select(large, Div(Splat(-1.f), t), Select(medium, Div(Sub(t, Splat(1.f)), Add(t, Splat(1.f))), t));
+        auto ret = Add(offset, Detail::AtanPolynomial(reduced));
+        ret = Select(Less(ratio, zero), Negate(ret), ret);
+        ret = Select(Less(xLanes, zero), Add(ret, Select(Less(yLanes, zero), Splat(-pi), Splat(pi))), ret);
+
+        const auto onAxis = Select(Greater(yLanes, zero), halfPi, Select(Less(yLanes, zero), Negate(halfPi), zero));
+        StoreUnaligned(out + i, Select(Equal(xLanes, zero), onAxis, ret));
+    }
+    for (; i < count; ++i)
+        out[i] = Atan2(y[i], x[i]);
+}
+
+// Correctly rounded like std::sqrt
+inline void Sqrt(const float* values, size_t count, float* out) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        Simd::StoreUnaligned(out + i, Simd::Sqrt(Simd::LoadUnaligned(values + i)));
+    for (; i < count; ++i)
+        out[i] = std::sqrt(values[i]);
+}
+
+// Sines and cosines of the multiples k * step for k < count. Every entry is computed directly from its
+// angle rather than by repeated rotation, so the error does not grow with k.
+class AngleTable {
+    float step;
+    std::vector<SineCosine> entries;
+
+public:
+    AngleTable(float step, size_t count)
+        : step(step) {
+        entries.reserve(count);
+        for (size_t k = 0; k < count; ++k)
+            entries.push_back(SinCos(static_cast<float>(k) * step));
+    }
+
+    float Step() const { return step; }
+    size_t Count() const { return entries.size(); }
+    const SineCosine& operator[](size_t k) const { return entries[k]; }
+
+    // Rotates a point in the XZ plane counterclockwise by k * step
+    Vector<2> Rotate(const Vector<2>& point, size_t k) const {
+        const auto& entry = entries[k];
+        return { point[0] * entry.cosine - point[1] * entry.sine, point[0] * entry.sine + point[1] * entry.cosine };
+    }
+
+    // Rotates count points by the same k * step, out may alias points
+    void Rotate(const Vector<2>* points, size_t count, size_t k, Vector<2>* out) const {
+        const auto cosine = entries[k].cosine;
+        const auto sine = entries[k].sine;
+        for (size_t i = 0; i < count; ++i) {
+            const auto x = points[i][0];
+            const auto z = points[i][1];
+            out[i] = { x * cosine - z * sine, x * sine + z * cosine };
+        }
+    }
+};
+
+} // namespace Geometry
@@ -2,6 +2,7 @@
 
 #include "Vector.hpp"
 #include "Matrix.hpp"
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 
@@ -23,6 +24,52 @@ constexpr float Degrees(float radians) {
     return radians * 180 / pi;
 }
 
+namespace Detail {
+// Taylor series evaluated in double after reducing the angle to [-pi, pi], accurate to float precision
+constexpr double ReduceAngle(double angle) {
+    constexpr double twoPi = 6.28318530717958647692;
+    const auto turns = static_cast<long long>(angle / twoPi);
+    angle -= static_cast<double>(turns) * twoPi;
+    if (angle > twoPi / 2)
+        angle -= twoPi;
+    else if (angle < -twoPi / 2)
+        angle += twoPi;
+    return angle;
+}
+
+constexpr double SinSeries(double angle) {
+    const auto square = angle * angle;
+    auto term = angle;
+    auto ret = angle;
+    for (int i = 1; i < 16; ++i) {
+        term *= -square / ((2 * i) * (2 * i + 1));
+        ret += term;
+    }
+    return ret;
+}
+
+constexpr double CosSeries(double angle) {
+    const auto square = angle * angle;
+    auto term = 1.0;
+    auto ret = 1.0;
+    for (int i = 1; i < 16; ++i) {
+        term *= -square / ((2 * i - 1) * (2 * i));
+        ret += term;
+    }
+    return ret;
+}
+} // namespace Detail
+
+// Compile time counterparts of std::sin and std::cos
+constexpr float Sin(float angle) {
+    return static_cast<float>(Detail::SinSeries(Detail::ReduceAngle(angle)));
+}
+
+constexpr float Cos(float angle) {
+    return static_cast<float>(Detail::CosSeries(Detail::ReduceAngle(angle)));
+}
+
+// Built once per frame from a runtime field of view, so accuracy matters more than the cost of std::tan
 inline Matrix<4> Perspective(float fov, float aspect, float nearPlane, float farPlane) {
     const auto s = 1.f / std::tan(Radians(fov) * 0.5f);
 
@@ -35,7 +82,7 @@ inline Matrix<4> Perspective(float fov, float aspect, float nearPlane, float far
     return ret;
 }
 
-inline Matrix<4> Ortho(float left, float right, float bottom, float top, float nearPlane, float farPlane) {
+constexpr Matrix<4> Ortho(float left, float right, float bottom, float top, float nearPlane, float farPlane) {
     auto ret = Matrix<4>::Identity();
     ret[0][0] = 2.f / (right - left);
     ret[1][1] = 2.f / (top - bottom);
@@ -1,65 +1,76 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <ostream>
-#include <stdexcept>
-#include <string>
+#include <type_traits>
+
+#include "Simd.hpp"
 
 namespace Geometry {
 
-template <size_t Size>
+class Rotation;
+
+// Scalar type defaults to float, other types such as double or Fixed work through the scalar fallback
+template <size_t Size, typename T = float>
 class Vector {
     static_assert(Size >= 2 && Size <= 4, "Vector of size lesser than 2 or bigger than 4 is not supported.");
-    std::array<float, Size> data;
+
+    // Float Vector<3> and Vector<4> live in a single aligned SIMD register, Vector<3> has one padding lane
+    constexpr static bool packed = Size >= 3 && std::is_same_v<T, float>;
+    constexpr static size_t storageSize = packed ? 4 : Size;
+
+    alignas(packed ? 16 : alignof(T)) std::array<T, storageSize> data;
+
+    Simd::Float4 Load() const { return Simd::Load(data.data()); }
+    void Store(Simd::Float4 value) { Simd::Store(data.data(), value); }
 
 public:
-    Vector()
-        : Vector(0.f) {}
+    using Scalar = T;
+
+    constexpr Vector()
+        : Vector(T(0)) {}
 
-    Vector(float x)
+    constexpr Vector(T x)
         : data() {
         for (auto& i : data)
             i = x;
     }
 
-    Vector(std::initializer_list<float>&& list) {
-        if (list.size() != Size)
-            throw std::invalid_argument("Can't initialize with list of size " + std::to_string(list.size()) + ". Size must be " + std::to_string(Size) + ".");
+    // One value per component, the count is checked at compile time
+    template <typename... Components, typename = std::enable_if_t<sizeof...(Components) == Size && std::conjunction_v<std::is_constructible<T, Components>...>>>
+    constexpr Vector(Components... components)
+        : data{ static_cast<T>(components)... } {}
 
-        auto otherIt = list.begin();
-        for (auto thisIt = data.begin(); thisIt != data.end(); ++thisIt, ++otherIt)
-            *thisIt = *otherIt;
+    T Magnitude() const {
+        using std::sqrt;
+        return sqrt(MagnitudeSquared());
     }
 
-    float Magnitude() const {
-        auto ret = 0.f;
-        for (auto& i : data)
-            ret += i * i;
-        return std::sqrt(ret);
+    // Compare against a squared length instead of taking the square root
+    T MagnitudeSquared() const {
+        return Dot(*this, *this);
     }
 
-    float& X() { return data[0]; }
-    float& Y() { return data[1]; }
-    float& Z() { return data[2]; }
+    constexpr T& X() { return data[0]; }
+    constexpr T& Y() { return data[1]; }
+    constexpr T& Z() { return data[2]; }
 
-    const float& X() const { return data[0]; }
-    const float& Y() const { return data[1]; }
-    const float& Z() const { return data[2]; }
+    constexpr const T& X() const { return data[0]; }
+    constexpr const T& Y() const { return data[1]; }
+    constexpr const T& Z() const { return data[2]; }
 
     Vector& Translate(const Vector& other) {
-        auto otherIt = other.data.begin();
-        for (auto thisIt = data.begin(); thisIt != data.end(); ++thisIt, ++otherIt)
-            *thisIt += *otherIt;
-        return *this;
+        return *this += other;
     }
 
-    Vector& Rotate(float angle, Vector axis) {
-        float const c = cos(angle);
-        float const s = sin(angle);
+    Vector& Rotate(T angle, Vector axis) {
+        T const c = static_cast<T>(cos(angle));
+        T const s = static_cast<T>(sin(angle));
 
         axis.Normalize();
-        Vector temp = axis * (1.f - c);
+        Vector temp = axis * (T(1) - c);
 
         Vector result;
         result[0] = (*this)[0] * (c + temp[0] * axis[0]) + (*this)[1] * (temp[1] * axis[0] - s * axis[2]) + (*this)[2] * (temp[2] * axis[0] + s * axis[1]);
@@ -68,193 +79,212 @@ public:
         return *this = result;
     }
 
+    // Defined in Quaternion.hpp
+    Vector& Rotate(const Rotation& rotation);
+
     Vector& Scale(Vector other) {
-        auto otherIt = other.data.begin();
-        for (auto thisIt = data.begin(); thisIt != data.end(); ++thisIt, ++otherIt)
-            *thisIt *= *otherIt;
-        return *this;
+        return *this *= other;
     }
 
+    // GEOMETRY_FAST_MATH makes this the same as NormalizeFast
     Vector& Normalize() {
+#ifdef GEOMETRY_FAST_MATH
+        return NormalizeFast();
+#else
         const auto mag = Magnitude();
-        if (mag == 0)
+        if (mag == T(0))
             return *this;
-        for (auto& i : data)
-            i /= mag;
-        return *this;
+        return *this /= Vector(mag);
+#endif
+    }
+
+    // Multiplies by the reciprocal magnitude instead of dividing every component, float vectors take it
+    // from Simd::ReciprocalSqrt. Within a few ulp of Normalize, zero vectors are left unchanged.
+    Vector& NormalizeFast() {
+        const auto squared = MagnitudeSquared();
+        if (squared == T(0))
+            return *this;
+        if constexpr (std::is_same_v<T, float>) {
+            return *this *= Vector(Simd::ReciprocalSqrt(squared));
+        } else {
+            using std::sqrt;
+            return *this *= Vector(T(1) / sqrt(squared));
+        }
     }
 
     Vector& Invert() {
-        for (auto& i : data)
-            i *= -1.f;
-        return *this;
+        return *this *= Vector(T(-1));
     }
 
     // Index operators
-    float& operator[](size_t index) { return data[index]; }
-    const float& operator[](size_t index) const { return data[index]; }
+    constexpr T& operator[](size_t index) { return data[index]; }
+    constexpr const T& operator[](size_t index) const { return data[index]; }
     // Dereference operator
-    const float* operator&() const { return &data[0]; }
+    const T* operator&() const { return &data[0]; }
     // Bool operators
-    friend bool operator==(const Vector& lhs, const Vector& rhs) { return lhs.data == rhs.data; }
-    friend bool operator!=(const Vector& lhs, const Vector& rhs) { return lhs.data != rhs.data; }
+    friend bool operator==(const Vector& lhs, const Vector& rhs) { return std::equal(lhs.data.begin(), lhs.data.begin() + Size, rhs.data.begin()); }
+    friend bool operator!=(const Vector& lhs, const Vector& rhs) { return !(lhs == rhs); }
     // Vector arithmetic operators
-    friend Vector operator+(Vector lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt += *rhsIt;
-        return lhs;
-    }
-
-    friend Vector operator-(Vector lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt -= *rhsIt;
-        return lhs;
-    }
-
-    friend Vector operator*(Vector lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt *= *rhsIt;
-        return lhs;
-    }
-
-    friend Vector operator/(Vector lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt /= *rhsIt;
-        return lhs;
-    }
+    friend Vector operator+(Vector lhs, const Vector& rhs) { return lhs += rhs; }
+    friend Vector operator-(Vector lhs, const Vector& rhs) { return lhs -= rhs; }
+    friend Vector operator*(Vector lhs, const Vector& rhs) { return lhs *= rhs; }
+    friend Vector operator/(Vector lhs, const Vector& rhs) { return lhs /= rhs; }
 
     friend Vector& operator+=(Vector& lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt += *rhsIt;
+        if constexpr (packed) {
+            lhs.Store(Simd::Add(lhs.Load(), rhs.Load()));
+        } else {
+            for (size_t i = 0; i < Size; ++i)
+                lhs.data[i] += rhs.data[i];
+        }
         return lhs;
     }
 
     friend Vector& operator-=(Vector& lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt -= *rhsIt;
+        if constexpr (packed) {
+            lhs.Store(Simd::Sub(lhs.Load(), rhs.Load()));
+        } else {
+            for (size_t i = 0; i < Size; ++i)
+                lhs.data[i] -= rhs.data[i];
+        }
         return lhs;
     }
 
     friend Vector& operator*=(Vector& lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt *= *rhsIt;
+        if constexpr (packed) {
+            lhs.Store(Simd::Mul(lhs.Load(), rhs.Load()));
+        } else {
+            for (size_t i = 0; i < Size; ++i)
+                lhs.data[i] *= rhs.data[i];
+        }
         return lhs;
     }
 
     friend Vector& operator/=(Vector& lhs, const Vector& rhs) {
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            *lhsIt /= *rhsIt;
+        if constexpr (packed) {
+            lhs.Store(Simd::Div(lhs.Load(), rhs.Load()));
+        } else {
+            for (size_t i = 0; i < Size; ++i)
+                lhs.data[i] /= rhs.data[i];
+        }
         return lhs;
     }
 
-    // Scalar arithmetic operators
-    friend Vector operator+(Vector vec, float scalar) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt += scalar;
-        return vec;
-    }
+    // Scalar arithmetic operators, element-wise with the scalar on the same side as in the expression
+    friend Vector operator+(Vector vec, T scalar) { return vec += Vector(scalar); }
+    friend Vector operator-(Vector vec, T scalar) { return vec -= Vector(scalar); }
+    friend Vector operator*(Vector vec, T scalar) { return vec *= Vector(scalar); }
+    friend Vector operator/(Vector vec, T scalar) { return vec /= Vector(scalar); }
+    friend Vector operator+(T scalar, Vector vec) { return vec += Vector(scalar); }
+    friend Vector operator-(T scalar, const Vector& vec) { return Vector(scalar) - vec; }
+    friend Vector operator*(T scalar, Vector vec) { return vec *= Vector(scalar); }
+    friend Vector operator/(T scalar, const Vector& vec) { return Vector(scalar) / vec; }
 
-    friend Vector operator-(Vector vec, float scalar) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt -= scalar;
-        return vec;
+    // Output stream operator
+    friend std::ostream& operator<<(std::ostream& os, const Vector& vec) {
+        os << "[";
+        for (size_t i = 0; i < Size; ++i)
+            os << vec.data[i] << ", ";
+        return os << "]";
     }
 
-    friend Vector operator*(Vector vec, float scalar) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt *= scalar;
-        return vec;
+    // Static methods
+    static Vector Normalized(Vector vec) {
+        return vec.Normalize();
     }
 
-    friend Vector operator/(Vector vec, float scalar) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt /= scalar;
-        return vec;
+    static Vector NormalizedFast(Vector vec) {
+        return vec.NormalizeFast();
     }
 
-    friend Vector operator+(float scalar, Vector vec) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt += scalar;
-        return vec;
+    static Vector Inverted(Vector vec) {
+        return vec.Invert();
     }
 
-    friend Vector operator-(float scalar, Vector vec) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt -= scalar;
-        return vec;
+    static T Dot(const Vector& lhs, const Vector& rhs) {
+        if constexpr (packed && Size == 3) {
+            return Simd::Sum3(Simd::Mul(lhs.Load(), rhs.Load()));
+        } else if constexpr (packed && Size == 4) {
+            return Simd::Sum4(Simd::Mul(lhs.Load(), rhs.Load()));
+        } else {
+            auto ret = T(0);
+            for (size_t i = 0; i < Size; ++i)
+                ret += lhs.data[i] * rhs.data[i];
+            return ret;
+        }
     }
 
-    friend Vector operator*(float scalar, Vector vec) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt *= scalar;
-        return vec;
+    static Vector Cross(const Vector& lhs, const Vector& rhs) {
+        if constexpr (packed && Size == 3) {
+            Vector ret;
+            ret.Store(Simd::Cross(lhs.Load(), rhs.Load()));
+            return ret;
+        } else {
+            return { lhs.Y() * rhs.Z() - rhs.Y() * lhs.Z(), lhs.Z() * rhs.X() - rhs.Z() * lhs.X(), lhs.X() * rhs.Y() - rhs.X() * lhs.Y() };
+        }
     }
 
-    friend Vector operator/(float scalar, Vector vec) {
-        for (auto lhsIt = vec.data.begin(); lhsIt != vec.data.end(); ++lhsIt)
-            *lhsIt /= scalar;
-        return vec;
+    // Componentwise minimum and maximum
+    static Vector Min(const Vector& lhs, const Vector& rhs) {
+        if constexpr (packed) {
+            Vector ret;
+            ret.Store(Simd::Min(lhs.Load(), rhs.Load()));
+            return ret;
+        } else {
+            Vector ret;
+            for (size_t i = 0; i < Size; ++i)
+                ret.data[i] = lhs.data[i] < rhs.data[i] ? lhs.data[i] : rhs.data[i];
+            return ret;
+        }
     }
 
-    // Output stream operator
-    friend std::ostream& operator<<(std::ostream& os, const Vector& vec) {
-        os << "[";
-        for (auto& i : vec.data)
-            os << i << ", ";
-        return os << "]";
+    static Vector Max(const Vector& lhs, const Vector& rhs) {
+        if constexpr (packed) {
+            Vector ret;
+            ret.Store(Simd::Max(lhs.Load(), rhs.Load()));
+            return ret;
+        } else {
+            Vector ret;
+            for (size_t i = 0; i < Size; ++i)
+                ret.data[i] = lhs.data[i] > rhs.data[i] ? lhs.data[i] : rhs.data[i];
+            return ret;
+        }
     }
 
-    // Static methods
-    static Vector Normalized(Vector vec) {
-        return vec.Normalize();
+    static T Distance(const Vector& lhs, const Vector& rhs) {
+        return (lhs - rhs).Magnitude();
     }
 
-    static Vector Inverted(Vector vec) {
-        return vec.Invert();
+    static T DistanceSquared(const Vector& lhs, const Vector& rhs) {
+        return (lhs - rhs).MagnitudeSquared();
     }
 
-    static float Dot(const Vector& lhs, const Vector& rhs) {
-        auto ret = 0.f;
-        auto rhsIt = rhs.data.begin();
-        for (auto lhsIt = lhs.data.begin(); lhsIt != lhs.data.end(); ++lhsIt, ++rhsIt)
-            ret += *lhsIt * *rhsIt;
-        return ret;
+    // Vector<2> holds the X and Z coordinates of the ground plane, Vector<4> gets a homogeneous 1
+    constexpr Vector<2, T> To2() const {
+        if constexpr (Size == 2)
+            return *this;
+        else
+            return { data[0], data[2] };
     }
 
-    static Vector Cross(const Vector& lhs, const Vector& rhs) {
-        return { lhs.Y() * rhs.Z() - rhs.Y() * lhs.Z(), lhs.Z() * rhs.X() - rhs.Z() * lhs.X(), lhs.X() * rhs.Y() - rhs.X() * lhs.Y() };
+    constexpr Vector<3, T> To3() const {
+        if constexpr (Size == 2)
+            return { data[0], T(0), data[1] };
+        else
+            return { data[0], data[1], data[2] };
     }
 
-    static float Distance(const Vector& lhs, const Vector& rhs) {
-        return (lhs - rhs).Magnitude();
+    constexpr Vector<4, T> To4() const {
+        if constexpr (Size == 2)
+            return { data[0], T(0), data[1], T(1) };
+        else if constexpr (Size == 3)
+            return { data[0], data[1], data[2], T(1) };
+        else
+            return { data[0], data[1], data[2], data[3] };
     }
-
-    Vector<2> To2() const { return { data[0], data[2] }; }
-    Vector<3> To3() const { return { data[0], data[1], data[2] }; }
-    Vector<4> To4() const { return { data[0], data[1], data[2], data[3] }; }
 };
 
-template <>
-inline Vector<3> Vector<2>::To3() const {
-    return { data[0], 0.f, data[1] };
-}
-
-template <>
-inline Vector<4> Vector<2>::To4() const {
-    return { data[0], 0.f, data[2], 1.f };
-}
-
-template <>
-inline Vector<4> Vector<3>::To4() const {
-    return { data[0], data[1], data[2], 1.f };
-}
+static_assert(alignof(Vector<3>) == Simd::alignment && sizeof(Vector<3>) == Simd::alignment, "Vector<3> must fill exactly one SIMD register.");
+static_assert(alignof(Vector<4>) == Simd::alignment && sizeof(Vector<4>) == Simd::alignment, "Vector<4> must fill exactly one SIMD register.");
 
 } // namespace Geometry
\ No newline at end of file
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "Allocator.hpp"
+#include "Simd.hpp"
+#include "Trigonometry.hpp"
+#include "Vector.hpp"
+
+namespace Geometry {
+
+// Structure of arrays counterpart of std::vector<Vector<Size>>. Every component lives in its own
+// contiguous lane, so the batch kernels below are plain loops over floats the compiler can vectorize.
+// Lanes start on a SIMD boundary, every block of four elements is read with an aligned load. Arrays
+// passed in or out by pointer have no such guarantee.
+template <size_t Size>
+class VectorArray {
+    std::array<aligned_vector<float>, Size> lanes;
+
+public:
+    VectorArray() = default;
+
+    explicit VectorArray(size_t count, const Vector<Size>& value = Vector<Size>()) {
+        for (size_t axis = 0; axis < Size; ++axis)
+            lanes[axis].assign(count, value[axis]);
+    }
+
+    size_t Count() const { return lanes[0].size(); }
+    bool Empty() const { return lanes[0].empty(); }
+
+    void Reserve(size_t count) {
+        for (auto& lane : lanes)
+            lane.reserve(count);
+    }
+
+    void Resize(size_t count) {
+        for (auto& lane : lanes)
+            lane.resize(count);
+    }
+
+    void Clear() {
+        for (auto& lane : lanes)
+            lane.clear();
+    }
+
+    void PushBack(const Vector<Size>& vec) {
+        for (size_t axis = 0; axis < Size; ++axis)
+            lanes[axis].push_back(vec[axis]);
+    }
+
+    Vector<Size> Get(size_t index) const {
+        Vector<Size> ret;
+        for (size_t axis = 0; axis < Size; ++axis)
+            ret[axis] = lanes[axis][index];
+        return ret;
+    }
+
+    void Set(size_t index, const Vector<Size>& vec) {
+        for (size_t axis = 0; axis < Size; ++axis)
+            lanes[axis][index] = vec[axis];
+    }
+
+    float* Lane(size_t axis) { return lanes[axis].data(); }
+    const float* Lane(size_t axis) const { return lanes[axis].data(); }
+
+    // this += a * x
+    VectorArray& Axpy(float a, const VectorArray& x) {
+        const auto count = Count();
+        const auto scalar = Simd::Splat(a);
+        for (size_t axis = 0; axis < Size; ++axis) {
+            auto* out = Lane(axis);
+            const auto* in = x.Lane(axis);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+                Simd::Store(out + i, Simd::Add(Simd::Load(out + i), Simd::Mul(scalar, Simd::Load(in + i))));
+            for (; i < count; ++i)
+                out[i] += a * in[i];
+        }
+        return *this;
+    }
+
+    VectorArray& Scale(float scalar) {
+        for (auto& lane : lanes)
+            for (auto& i : lane)
+                i *= scalar;
+        return *this;
+    }
+
+    // Same results as calling Vector::Normalize on every element, zero vectors are left unchanged
+    VectorArray& Normalize() {
+#ifdef GEOMETRY_FAST_MATH
+        const auto one = Simd::Splat(1.f);
+        const auto zero = Simd::Splat(0.f);
+        return ScaleBy(
+            [&](Simd::Float4 squared, size_t) { return Simd::Select(Simd::Equal(squared, zero), one, Simd::ReciprocalSqrt(squared)); },
+            [&](float squared, size_t) { return squared == 0.f ? 1.f : Simd::ReciprocalSqrt(squared); });
+#else
+        const auto count = Count();
+        const auto one = Simd::Splat(1.f);
+        const auto zero = Simd::Splat(0.f);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            auto magnitude = Simd::Sqrt(SquaredMagnitudes(i));
+            magnitude = Simd::Select(Simd::Equal(magnitude, zero), one, magnitude);
+            for (size_t axis = 0; axis < Size; ++axis)
+                Simd::Store(Lane(axis) + i, Simd::Div(Simd::Load(Lane(axis) + i), magnitude));
+        }
+        for (; i < count; ++i) {
+            const auto magnitude = std::sqrt(SquaredMagnitude(i));
+            if (magnitude == 0.f)
+                continue;
+            for (size_t axis = 0; axis < Size; ++axis)
+                lanes[axis][i] /= magnitude;
+        }
+        return *this;
+#endif
+    }
+
+    VectorArray& ClampMagnitude(float maxMagnitude) {
+        const auto limit = Simd::Splat(maxMagnitude);
+        const auto one = Simd::Splat(1.f);
+        return ScaleBy(
+            [&](Simd::Float4 squared, size_t) {
+                const auto magnitude = Simd::Sqrt(squared);
+                return Simd::Select(Simd::Greater(magnitude, limit), Simd::Div(limit, magnitude), one);
+            },
+            [&](float squared, size_t) {
+                const auto magnitude = std::sqrt(squared);
+                return magnitude > maxMagnitude ? maxMagnitude / magnitude : 1.f;
+            });
+    }
+
+    // Multiplies every element longer than its limit by factor, limits holds one non-negative value per element
+    VectorArray& ScaleAbove(const float* limits, float factor) {
+        const auto scale = Simd::Splat(factor);
+        const auto one = Simd::Splat(1.f);
+        return ScaleBy(
+            [&](Simd::Float4 squared, size_t i) {
+                const auto limit = Simd::LoadUnaligned(limits + i);
+                return Simd::Select(Simd::Greater(squared, Simd::Mul(limit, limit)), scale, one);
+            },
+            [&](float squared, size_t i) { return squared > limits[i] * limits[i] ? factor : 1.f; });
+    }
+
+    // Output arrays must hold Count() floats
+    void Magnitudes(float* out) const {
+        Dot(*this, *this, out);
+        Sqrt(out, Count(), out);
+    }
+
+    // Polar coordinates in the XZ plane in one pass, radii match Vector::To2().Magnitude() and angles are
+    // what Atan2(z, x) returns. Either output may be null when only the other one is needed.
+    void Polar(float* radii, float* angles) const {
+        constexpr size_t zAxis = Size == 2 ? 1 : 2;
+        const auto count = Count();
+        const auto* x = Lane(0);
+        const auto* z = Lane(zAxis);
+        if (radii) {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const auto xLanes = Simd::Load(x + i);
+                const auto zLanes = Simd::Load(z + i);
+                Simd::StoreUnaligned(radii + i, Simd::Add(Simd::Mul(xLanes, xLanes), Simd::Mul(zLanes, zLanes)));
+            }
+            for (; i < count; ++i)
+                radii[i] = x[i] * x[i] + z[i] * z[i];
+            Sqrt(radii, count, radii);
+        }
+        if (angles)
+            Atan2(z, x, count, angles);
+    }
+
+    // Static methods
+    // Summed in component order like Vector::Dot so results are bit identical
+    static void Dot(const VectorArray& lhs, const VectorArray& rhs, float* out) {
+        const auto count = lhs.Count();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            auto sum = Simd::Mul(Simd::Load(lhs.Lane(0) + i), Simd::Load(rhs.Lane(0) + i));
+            for (size_t axis = 1; axis < Size; ++axis)
+                sum = Simd::Add(sum, Simd::Mul(Simd::Load(lhs.Lane(axis) + i), Simd::Load(rhs.Lane(axis) + i)));
+            Simd::StoreUnaligned(out + i, sum);
+        }
+        for (; i < count; ++i) {
+            auto sum = lhs.lanes[0][i] * rhs.lanes[0][i];
+            for (size_t axis = 1; axis < Size; ++axis)
+                sum += lhs.lanes[axis][i] * rhs.lanes[axis][i];
+            out[i] = sum;
+        }
+    }
+
+    // Distance between elements with the same index
+    static void Distances(const VectorArray& lhs, const VectorArray& rhs, float* out) {
+        const auto count = lhs.Count();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            auto sum = Simd::Splat(0.f);
+            for (size_t axis = 0; axis < Size; ++axis) {
+                const auto delta = Simd::Sub(Simd::Load(lhs.Lane(axis) + i), Simd::Load(rhs.Lane(axis) + i));
+                sum = Simd::Add(sum, Simd::Mul(delta, delta));
+            }
+            Simd::StoreUnaligned(out + i, Simd::Sqrt(sum));
+        }
+        for (; i < count; ++i) {
+            auto sum = 0.f;
+            for (size_t axis = 0; axis < Size; ++axis) {
+                const auto delta = lhs.lanes[axis][i] - rhs.lanes[axis][i];
+                sum += delta * delta;
+            }
+            out[i] = std::sqrt(sum);
+        }
+    }
+
+    // Distance of every element to a single point
+    static void Distances(const VectorArray& points, const Vector<Size>& point, float* out) {
+        const auto count = points.Count();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            auto sum = Simd::Splat(0.f);
+            for (size_t axis = 0; axis < Size; ++axis) {
+                const auto delta = Simd::Sub(Simd::Load(points.Lane(axis) + i), Simd::Splat(point[axis]));
+                sum = Simd::Add(sum, Simd::Mul(delta, delta));
+            }
+            Simd::StoreUnaligned(out + i, Simd::Sqrt(sum));
+        }
+        for (; i < count; ++i) {
+            auto sum = 0.f;
+            for (size_t axis = 0; axis < Size; ++axis) {
+                const auto delta = points.lanes[axis][i] - point[axis];
+                sum += delta * delta;
+            }
+            out[i] = std::sqrt(sum);
+        }
+    }
+
+private:
+    Simd::Float4 SquaredMagnitudes(size_t index) const {
+        auto ret = Simd::Mul(Simd::Load(Lane(0) + index), Simd::Load(Lane(0) + index));
+        for (size_t axis = 1; axis < Size; ++axis)
+            ret = Simd::Add(ret, Simd::Mul(Simd::Load(Lane(axis) + index), Simd::Load(Lane(axis) + index)));
+        return ret;
+    }
+
+    float SquaredMagnitude(size_t index) const {
+        auto ret = lanes[0][index] * lanes[0][index];
+        for (size_t axis = 1; axis < Size; ++axis)
+            ret += lanes[axis][index] * lanes[axis][index];
+        return ret;
+    }
+
+    // Multiplies every element by a factor computed from its squared magnitude and index, four elements at a time
+    template <typename Block, typename Single>
+    VectorArray& ScaleBy(Block block, Single single) {
+        const auto count = Count();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto factor = block(SquaredMagnitudes(i), i);
+            for (size_t axis = 0; axis < Size; ++axis)
+                Simd::Store(Lane(axis) + i, Simd::Mul(Simd::Load(Lane(axis) + i), factor));
+        }
+        for (; i < count; ++i) {
+            const auto factor = single(SquaredMagnitude(i), i);
+            for (size_t axis = 0; axis < Size; ++axis)
+                lanes[axis][i] *= factor;
+        }
+        return *this;
+    }
+};
+
+} // namespace Geometry
@@ -1,18 +1,17 @@
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "Geometry"
 
-const unsigned SEGMENTS = 36;
-const float RADIUS = 40.f;
+constexpr unsigned SEGMENTS = 36;
+constexpr float RADIUS = 40.f;
 
-const float ANGLE = -2 * Geometry::pi / float(SEGMENTS);
-const float S = sinf(ANGLE);
-const float C = cosf(ANGLE);
+constexpr float ANGLE = -2 * Geometry::pi / float(SEGMENTS);
 
-const float BRICK_WIDTH = 3.f;
-const float BRICK_HEIGHT = 3.f;
+constexpr float BRICK_WIDTH = 3.f;
+constexpr float BRICK_HEIGHT = 3.f;
 
 inline void EmplaceVert(std::vector<float>& vec, float x, float y, float z, float nx, float ny, float nz, float u, float v) {
     vec.emplace_back(x);
@@ -29,12 +28,8 @@ inline void EmplaceFiller(std::vector<float>& vec, float x, float y, float z) {
     EmplaceVert(vec, x, y, z, 0.f, 0.f, 0.f, 0.f, 0.f);
 }
 
-inline void Rotate(float& x, float& z) {
-    const auto newX = x * C - z * S;
-    const auto newZ = x * S + z * C;
-    x = newX;
-    z = newZ;
-}
+// Sines and cosines of every multiple of ANGLE a mesh can reach
+inline const Geometry::AngleTable SEGMENT_ANGLES(ANGLE, SEGMENTS + 1);
 
 inline std::vector<float> GetGroundVertices() {
     std::vector<float> ret;
@@ -43,11 +38,10 @@ inline std::vector<float> GetGroundVertices() {
     // Center
     EmplaceVert(ret, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.5f, 0.f);
 
-    float x = RADIUS;
-    float z = 0.f;
+    const Geometry::Vector<2> start{ RADIUS, 0.f };
     for (unsigned j = 0; j <= SEGMENTS; ++j) {
-        EmplaceVert(ret, x, 0.f, z, 0.f, 1.f, 0.f, j % 2 == 0 ? 0.f : 1.f, 1.f);
-        Rotate(x, z);
+        const auto point = SEGMENT_ANGLES.Rotate(start, j);
+        EmplaceVert(ret, point[0], 0.f, point[1], 0.f, 1.f, 0.f, j % 2 == 0 ? 0.f : 1.f, 1.f);
     }
     return ret;
 }
@@ -56,50 +50,45 @@ inline std::vector<float> GetBrickVertices(float distance, unsigned segmentsCoun
     std::vector<float> ret;
     ret.reserve(segmentsCount * 20);
 
+    // Inner and outer points of every segment boundary, each rotated straight from the start
+    const Geometry::Vector<2> start[] = { { distance, 0.f }, { distance + BRICK_WIDTH, 0.f } };
+    std::vector<std::array<Geometry::Vector<2>, 2>> edges(segmentsCount + 1);
+    for (unsigned j = 0; j <= segmentsCount; ++j) {
+        SEGMENT_ANGLES.Rotate(start, 2, j, edges[j].data());
+    }
+
     // Front
-    float x = distance;
-    float z = 0.f;
     for (unsigned j = 0; j <= segmentsCount; ++j) {
+        const auto x = edges[j][0][0];
+        const auto z = edges[j][0][1];
         EmplaceVert(ret, x, 0, z, -x, 0.f, -z, j, 1.f);
         EmplaceVert(ret, x, BRICK_HEIGHT, z, -x, 0.f, -z, j, 0.f);
-        if (j != segmentsCount) {
-            Rotate(x, z);
-        }
     }
-    EmplaceFiller(ret, x, BRICK_HEIGHT, z);
+    EmplaceFiller(ret, edges.back()[0][0], BRICK_HEIGHT, edges.back()[0][1]);
 
     // Back
-    x = distance + BRICK_WIDTH;
-    z = 0.f;
-
-    EmplaceFiller(ret, x, BRICK_HEIGHT, z);
+    EmplaceFiller(ret, distance + BRICK_WIDTH, BRICK_HEIGHT, 0.f);
     for (unsigned j = 0; j <= segmentsCount; ++j) {
+        const auto x = edges[j][1][0];
+        const auto z = edges[j][1][1];
         EmplaceVert(ret, x, BRICK_HEIGHT, z, x, 0.f, z, j, 1.f);
         EmplaceVert(ret, x, 0, z, x, 0.f, z, j, 2.f);
-        if (j != segmentsCount) {
-            Rotate(x, z);
-        }
     }
-    EmplaceFiller(ret, x, 0, z);
+    EmplaceFiller(ret, edges.back()[1][0], 0, edges.back()[1][1]);
 
     // Top
-    float x1 = distance;
-    float z1 = 0.f;
-    float x2 = distance + BRICK_WIDTH;
-    float z2 = 0.f;
-
-    EmplaceFiller(ret, x1, BRICK_HEIGHT, z1);
+    EmplaceFiller(ret, distance, BRICK_HEIGHT, 0.f);
     for (unsigned j = 0; j <= segmentsCount; ++j) {
-        EmplaceVert(ret, x1, BRICK_HEIGHT, z1, 0.f, 1.f, 0.f, j, 0.f);
-        EmplaceVert(ret, x2, BRICK_HEIGHT, z2, 0.f, 1.f, 0.f, j, 1.f);
-        if (j != segmentsCount) {
-            Rotate(x1, z1);
-            Rotate(x2, z2);
-        }
+        EmplaceVert(ret, edges[j][0][0], BRICK_HEIGHT, edges[j][0][1], 0.f, 1.f, 0.f, j, 0.f);
+        EmplaceVert(ret, edges[j][1][0], BRICK_HEIGHT, edges[j][1][1], 0.f, 1.f, 0.f, j, 1.f);
     }
-    EmplaceFiller(ret, x2, BRICK_HEIGHT, z2);
+    EmplaceFiller(ret, edges.back()[1][0], BRICK_HEIGHT, edges.back()[1][1]);
 
     // Caps
+    const auto x1 = edges.back()[0][0];
+    const auto z1 = edges.back()[0][1];
+    const auto x2 = edges.back()[1][0];
+    const auto z2 = edges.back()[1][1];
     EmplaceVert(ret, x2, BRICK_HEIGHT, z2, z2, 0.f, -x2, 0.f, 0.f);
     EmplaceVert(ret, x1, BRICK_HEIGHT, z1, z2, 0.f, -x2, 1.f, 0.f);
     EmplaceVert(ret, x2, 0.f, z2, z2, 0.f, -x2, 0.f, 1.f);
@@ -114,10 +103,10 @@ inline std::vector<float> GetBrickVertices(float distance, unsigned segmentsCoun
     return ret;
 }
 
-const float PAD_DISTANCE = RADIUS * 3.f / 4.f;
-const float PAD_SEGMENTS = SEGMENTS / 6.f;
-const float BRICK_DISTANCE = RADIUS / 4.f;
-const float BRICK_SEGMENTS = SEGMENTS / 12.f;
+constexpr float PAD_DISTANCE = RADIUS * 3.f / 4.f;
+constexpr float PAD_SEGMENTS = SEGMENTS / 6.f;
+constexpr float BRICK_DISTANCE = RADIUS / 4.f;
+constexpr float BRICK_SEGMENTS = SEGMENTS / 12.f;
 
 const std::vector<float> GROUND_VERTICES = GetGroundVertices();
 const std::vector<float> PAD_VERTICES = GetBrickVertices(PAD_DISTANCE, PAD_SEGMENTS);